@@ -0,0 +1,75 @@
+#include "Bookmarks.h"
+#include <algorithm>
+
+namespace LogParser {
+
+    bool Bookmarks::toggle(uint32_t row) {
+        auto it = std::lower_bound(rows.begin(), rows.end(), row);
+        const size_t i = it - rows.begin();
+        if (it != rows.end() && *it == row) {
+            rows.erase(it);
+            notes.erase(notes.begin() + i);
+            bits[row / 64] &= ~((uint64_t)1 << (row % 64));
+            return false;
+        }
+        rows.insert(it, row);
+        notes.insert(notes.begin() + i, std::string());
+        if (row / 64 >= bits.size()) {
+            bits.resize(row / 64 + 1, 0);
+        }
+        bits[row / 64] |= (uint64_t)1 << (row % 64);
+        return true;
+    }
+
+    void Bookmarks::clear() {
+        rows.clear();
+        notes.clear();
+        bits.clear();
+    }
+
+    void Bookmarks::setNote(uint32_t row, const std::string& note) {
+        auto it = std::lower_bound(rows.begin(), rows.end(), row);
+        if (it != rows.end() && *it == row) {
+            notes[it - rows.begin()] = note;
+        }
+    }
+
+    const std::string& Bookmarks::getNote(uint32_t row) const {
+        static const std::string empty;
+        auto it = std::lower_bound(rows.begin(), rows.end(), row);
+        return it != rows.end() && *it == row ? notes[it - rows.begin()] : empty;
+    }
+
+    void Bookmarks::getViewPositions(const std::vector<uint32_t>& view, bool view_ascending, std::vector<uint32_t>* out) const {
+        out->clear();
+        if (rows.empty()) {
+            return;
+        }
+        if (view_ascending) {
+            for (uint32_t row : rows) {
+                auto it = std::lower_bound(view.begin(), view.end(), row);
+                if (it != view.end() && *it == row) {
+                    out->push_back((uint32_t)(it - view.begin()));
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < view.size(); i++) {
+            if (contains(view[i])) {
+                out->push_back((uint32_t)i);
+            }
+        }
+    }
+
+    int64_t find_next_bookmark(const std::vector<uint32_t>& positions, int64_t position, bool forward) {
+        if (positions.empty()) {
+            return -1;
+        }
+        if (forward) {
+            auto it = position < 0 ? positions.begin() : std::upper_bound(positions.begin(), positions.end(), (uint32_t)position);
+            return it != positions.end() ? *it : positions.front();
+        }
+        auto it = position < 0 ? positions.end() : std::lower_bound(positions.begin(), positions.end(), (uint32_t)position);
+        return it != positions.begin() ? *(it - 1) : positions.back();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LogParser {
+
+    // Bookmarked rows, keyed by row id (index into LogStats::logs) so they survive filtering and sorting,
+    // each with an optional note. Ids are kept sorted, with a bitmap next to them for O(1) lookups while
+    // drawing rows.
+    class Bookmarks {
+    public:
+        // Returns true if the row is bookmarked afterwards.
+        bool toggle(uint32_t row);
+        bool contains(uint32_t row) const {
+            return row / 64 < bits.size() && (bits[row / 64] >> (row % 64)) & 1;
+        }
+        void clear();
+
+        void setNote(uint32_t row, const std::string& note);
+        const std::string& getNote(uint32_t row) const;
+
+        const std::vector<uint32_t>& getRows() const { return rows; }
+        size_t size() const { return rows.size(); }
+        bool empty() const { return rows.empty(); }
+
+        // Positions in view of the bookmarked rows it contains, ascending.
+        // An ascending view costs O(bookmarks * log view), any other order O(view).
+        void getViewPositions(const std::vector<uint32_t>& view, bool view_ascending, std::vector<uint32_t>* out) const;
+
+    private:
+        std::vector<uint32_t> rows;
+        std::vector<std::string> notes;     // Parallel to rows
+        std::vector<uint64_t> bits;
+    };
+
+    // Position of the next (or previous) bookmark in a view after (or before) position, wrapping around, from
+    // the ascending positions returned by getViewPositions(). position may be -1. Returns -1 if positions is empty.
+    int64_t find_next_bookmark(const std::vector<uint32_t>& positions, int64_t position, bool forward);
+}
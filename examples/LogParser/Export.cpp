@@ -0,0 +1,223 @@
+#include "Export.h"
+#include <cstdio>
+#include <cstring>
+
+namespace LogParser {
+
+    // Output buffer written to the file in large blocks. Spans larger than the buffer are written directly.
+    class ExportWriter {
+    public:
+        static const size_t BufferSize = 4 * 1024 * 1024;
+
+        explicit ExportWriter(FILE* file) : file(file), buffer(BufferSize) {}
+
+        void append(const char* s, size_t n) {
+            if (used + n > BufferSize) {
+                flush();
+                if (n > BufferSize) {
+                    write(s, n);
+                    return;
+                }
+            }
+            memcpy(buffer.data() + used, s, n);
+            used += n;
+        }
+        void append(const std::string& s) { append(s.data(), s.size()); }
+        void append(const char* s) { append(s, strlen(s)); }
+        void put(char c) {
+            if (used == BufferSize) {
+                flush();
+            }
+            buffer[used++] = c;
+        }
+
+        void flush() {
+            write(buffer.data(), used);
+            used = 0;
+        }
+
+        bool failed = false;
+        int64_t bytes_written = 0;
+
+    private:
+        void write(const char* s, size_t n) {
+            if (n > 0 && !failed) {
+                failed = fwrite(s, 1, n, file) != n;
+                bytes_written += (int64_t)n;
+            }
+        }
+
+        FILE* file;
+        std::vector<char> buffer;
+        size_t used = 0;
+    };
+
+    // Quoted, with '"' doubled.
+    static void write_csv_field(ExportWriter* out, const char* s, size_t n) {
+        const char* end = s + n;
+        out->put('"');
+        while (s < end) {
+            const char* quote = (const char*)memchr(s, '"', end - s);
+            if (quote == nullptr) {
+                out->append(s, end - s);
+                break;
+            }
+            out->append(s, quote + 1 - s);
+            out->put('"');
+            s = quote + 1;
+        }
+        out->put('"');
+    }
+
+    static void write_json_string(ExportWriter* out, const char* s, size_t n) {
+        static const char hex[] = "0123456789abcdef";
+        const char* end = s + n;
+        out->put('"');
+        while (s < end) {
+            // Copy the run of characters that need no escaping in one go
+            const char* run = s;
+            while (s < end && (uint8_t)*s >= 0x20 && *s != '"' && *s != '\\') {
+                s++;
+            }
+            out->append(run, s - run);
+            if (s == end) {
+                break;
+            }
+            const char c = *s++;
+            switch (c) {
+            case '"': out->append("\\\"", 2); break;
+            case '\\': out->append("\\\\", 2); break;
+            case '\n': out->append("\\n", 2); break;
+            case '\r': out->append("\\r", 2); break;
+            case '\t': out->append("\\t", 2); break;
+            default: {
+                const char esc[6] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF] };
+                out->append(esc, 6);
+                break;
+            }
+            }
+        }
+        out->put('"');
+    }
+
+    static void write_record(ExportWriter* out, const LogDetailNew& d, ExportFormat format) {
+        char id[24];
+        switch (format) {
+        case ExportFormat_Raw:
+            // The header line up to the message, then content, continuation lines included. Native headers
+            // '[LVL thread,MM-DD hh:mm:ss.fff]:' are not stored but rebuilt from the fields.
+            if (d.raw_prefix.empty()) {
+                out->put('[');
+                out->append(d.prority);
+                out->put(' ');
+                out->append(*d.thread_name);
+                out->put(',');
+                out->append(d.dt);
+                out->append("]:", 2);
+            }
+            else {
+                out->append(d.raw_prefix);
+            }
+            out->append(d.content.data() + d.raw_content_skip, d.content.size() - d.raw_content_skip);
+            out->put('\n');
+            break;
+        case ExportFormat_Csv:
+            // Every text field is quoted: ISO 8601 times may have a ',' before the fraction
+            out->append(id, snprintf(id, sizeof(id), "%ld,", d.id));
+            write_csv_field(out, d.dt.data(), d.dt.size());
+            out->put(',');
+            write_csv_field(out, d.prority.data(), d.prority.size());
+            out->put(',');
+            write_csv_field(out, d.thread_name->data(), d.thread_name->size());
+            out->put(',');
+            write_csv_field(out, d.file_name->data(), d.file_name->size());
+            out->put(',');
+            write_csv_field(out, d.content.data(), d.content.size());
+            out->put('\n');
+            break;
+        case ExportFormat_Ndjson:
+            out->append(id, snprintf(id, sizeof(id), "{\"id\":%ld", d.id));
+            out->append(",\"time\":");
+            write_json_string(out, d.dt.data(), d.dt.size());
+            out->append(",\"level\":");
+            write_json_string(out, d.prority.data(), d.prority.size());
+            out->append(",\"thread\":");
+            write_json_string(out, d.thread_name->data(), d.thread_name->size());
+            out->append(",\"file\":");
+            write_json_string(out, d.file_name->data(), d.file_name->size());
+            out->append(",\"content\":");
+            write_json_string(out, d.content.data(), d.content.size());
+            out->append("}\n", 2);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool export_rows(const LogStats& stats, const std::vector<uint32_t>& rows, const std::string& path, ExportFormat format,
+        ExportStats* export_stats, const std::atomic<bool>* cancel, std::string* error) {
+        if (export_stats != nullptr) {
+            export_stats->total_rows = (int64_t)rows.size();
+            export_stats->rows_written = 0;
+            export_stats->bytes_written = 0;
+            export_stats->start_ns = now_ns();
+            export_stats->end_ns = 0;
+        }
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            if (error != nullptr) {
+                *error = "Failed to open " + path;
+            }
+            return false;
+        }
+        // ExportWriter already writes in large blocks
+        setvbuf(file, nullptr, _IONBF, 0);
+
+        const size_t progress_interval = 4096;
+        ExportWriter out(file);
+        if (format == ExportFormat_Csv) {
+            out.append("id,time,level,thread,file,content\n");
+        }
+        for (size_t i = 0; i < rows.size() && !out.failed; i++) {
+            write_record(&out, stats.logs[rows[i]], format);
+            if ((i + 1) % progress_interval == 0) {
+                if (export_stats != nullptr) {
+                    export_stats->rows_written.store((int64_t)(i + 1), std::memory_order_relaxed);
+                    export_stats->bytes_written.store(out.bytes_written, std::memory_order_relaxed);
+                }
+                if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+        }
+        out.flush();
+        const bool closed = fclose(file) == 0;
+
+        if (export_stats != nullptr) {
+            if (!cancel || !cancel->load(std::memory_order_relaxed)) {
+                export_stats->rows_written.store((int64_t)rows.size(), std::memory_order_relaxed);
+            }
+            export_stats->bytes_written.store(out.bytes_written, std::memory_order_relaxed);
+            export_stats->end_ns = now_ns();
+        }
+        if (out.failed || !closed) {
+            if (error != nullptr) {
+                *error = "Failed to write " + path;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    ExportJob::ExportJob(const LogStats* stats, std::vector<uint32_t> rows, std::string path, ExportFormat format)
+        : stats(stats), rows(std::move(rows)), path(std::move(path)), format(format) {}
+
+    void ExportJob::start() {
+        job.start([this] { run(); });
+    }
+
+    void ExportJob::run() {
+        succeeded = export_rows(*stats, rows, path, format, &export_stats, job.getCancelFlag(), &error);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    enum ExportFormat {
+        ExportFormat_Raw,       // Records as they were in the log files
+        ExportFormat_Csv,       // id,time,level,thread,file,content with a header line
+        ExportFormat_Ndjson,    // One JSON object per record
+        ExportFormat_COUNT
+    };
+
+    // Progress of an export, written by the exporting thread and read by the UI thread.
+    struct ExportStats {
+        std::atomic<int64_t> total_rows{ 0 };
+        std::atomic<int64_t> rows_written{ 0 };
+        std::atomic<int64_t> bytes_written{ 0 };
+        std::atomic<int64_t> start_ns{ 0 };
+        std::atomic<int64_t> end_ns{ 0 };
+    };
+
+    // Writes stats.logs[rows[i]] to path in the given format. Records are formatted straight from their
+    // fields into a large buffer which is written out whenever it is full, so the cost is one copy per byte.
+    // Returns false and sets error if the file cannot be written; a cancelled export leaves a partial file.
+    bool export_rows(const LogStats& stats, const std::vector<uint32_t>& rows, const std::string& path, ExportFormat format,
+        ExportStats* export_stats = nullptr, const std::atomic<bool>* cancel = nullptr, std::string* error = nullptr);
+
+    // One export running on its own thread. stats must not change until the job is finished or destroyed.
+    class ExportJob {
+    public:
+        ExportJob(const LogStats* stats, std::vector<uint32_t> rows, std::string path, ExportFormat format);
+
+        void start();
+        void cancel() { job.cancel(); }
+        bool isRunning() const { return job.isRunning(); }
+        bool isCancelled() const { return job.isCancelled(); }
+        const std::string& getPath() const { return path; }
+        // Only valid once the job is finished
+        bool hasSucceeded() const { return succeeded; }
+        const std::string& getError() const { return error; }
+
+        ExportStats export_stats;
+
+    private:
+        void run();
+
+        const LogStats* stats;
+        std::vector<uint32_t> rows;
+        std::string path;
+        ExportFormat format;
+        bool succeeded = false;
+        std::string error;
+        BackgroundJob job;
+    };
+}
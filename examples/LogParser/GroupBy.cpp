@@ -0,0 +1,114 @@
+#include "GroupBy.h"
+#include "Parallel.h"
+
+namespace LogParser {
+
+    static void merge_group(GroupBy::Group* dst, const GroupBy::Group& src) {
+        dst->count += src.count;
+        for (int lv = 0; lv < LogLevel_COUNT; lv++) {
+            dst->level_counts[lv] += src.level_counts[lv];
+        }
+        if (src.first_ts >= 0 && (dst->first_ts < 0 || src.first_ts < dst->first_ts)) {
+            dst->first_ts = src.first_ts;
+        }
+        if (src.last_ts > dst->last_ts) {
+            dst->last_ts = src.last_ts;
+        }
+    }
+
+    void GroupBy::setKey(GroupKey new_key) {
+        if (new_key != key) {
+            key = new_key;
+            clear();
+        }
+    }
+
+    void GroupBy::clear() {
+        row_count = 0;
+        groups.clear();
+        names.clear();
+        name_keys.clear();
+    }
+
+    void GroupBy::addNames(const std::unordered_map<std::string, std::shared_ptr<const std::string>>& name_map) {
+        for (const auto& kv : name_map) {
+            if (name_keys.emplace(kv.second.get(), (uint32_t)names.size()).second) {
+                names.push_back(kv.second.get());
+            }
+        }
+    }
+
+    uint32_t GroupBy::keyOf(const LogDetailNew& d) const {
+        switch (key) {
+        case GroupKey_Thread: return name_keys.find(d.thread_name)->second;
+        case GroupKey_File: return name_keys.find(d.file_name)->second;
+        case GroupKey_Level: return d.level;
+        case GroupKey_Template: return d.template_id;
+        default: return 0;
+        }
+    }
+
+    bool GroupBy::update(const LogStats& stats, const std::vector<uint32_t>& rows) {
+        if (rows.size() < row_count) {
+            clear();
+        }
+        if (rows.size() == row_count) {
+            return false;
+        }
+
+        // Dense keys for the names first, the workers only read the map
+        size_t key_count;
+        switch (key) {
+        case GroupKey_Thread: addNames(stats.thread_name_map); key_count = names.size(); break;
+        case GroupKey_File: addNames(stats.file_name_map); key_count = names.size(); break;
+        case GroupKey_Level: key_count = LogLevel_COUNT; break;
+        case GroupKey_Template: key_count = std::max(stats.templates.size(), (size_t)1); break;
+        default: key_count = 1; break;
+        }
+        groups.resize(std::max(groups.size(), key_count));
+
+        const size_t begin = row_count;
+        const size_t count = rows.size() - begin;
+        const int workers = get_worker_count(count);
+        std::vector<std::vector<Group>> partials(workers - 1, std::vector<Group>(key_count));
+        const uint32_t* view = rows.data() + begin;
+        const LogDetailNew* logs = stats.logs.data();
+        parallel_for_chunks(workers, count, [&](int w, size_t chunk_begin, size_t chunk_end) {
+            // Worker 0 aggregates straight into the result
+            Group* out = w == 0 ? groups.data() : partials[w - 1].data();
+            for (size_t i = chunk_begin; i < chunk_end; i++) {
+                const LogDetailNew& d = logs[view[i]];
+                Group& g = out[keyOf(d)];
+                g.count++;
+                g.level_counts[d.level]++;
+                if (d.ts >= 0) {
+                    if (g.first_ts < 0 || d.ts < g.first_ts) {
+                        g.first_ts = d.ts;
+                    }
+                    if (d.ts > g.last_ts) {
+                        g.last_ts = d.ts;
+                    }
+                }
+            }
+        });
+        for (const std::vector<Group>& partial : partials) {
+            for (size_t k = 0; k < key_count; k++) {
+                if (partial[k].count > 0) {
+                    merge_group(&groups[k], partial[k]);
+                }
+            }
+        }
+        row_count = rows.size();
+        return true;
+    }
+
+    std::string GroupBy::getLabel(const LogStats& stats, uint32_t group) const {
+        switch (key) {
+        case GroupKey_Thread: return *names[group];
+        case GroupKey_File: return getFileName(*names[group]);
+        case GroupKey_Level: return get_level_name((LogLevel)group);
+        case GroupKey_Template: return group < stats.templates.size() ? stats.templates[group] : std::string();
+        default: return std::string();
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    enum GroupKey {
+        GroupKey_Thread,
+        GroupKey_Level,
+        GroupKey_File,
+        GroupKey_Template,
+        GroupKey_COUNT
+    };
+
+    // Row count, count per level and time range of the rows of a view, grouped by one column.
+    // Every worker aggregates a contiguous chunk of the rows into its own table of partial aggregates,
+    // indexed by a dense key, and the tables are merged at the end. Rows appended to the view since the
+    // last update() are aggregated on their own and merged in, so tailing an import stays cheap.
+    class GroupBy {
+    public:
+        struct Group {
+            uint64_t count = 0;
+            uint64_t level_counts[LogLevel_COUNT] = {};
+            int64_t first_ts = -1;      // -1 if no row of the group has a valid timestamp
+            int64_t last_ts = -1;
+        };
+
+        // Changing the key clears the aggregates.
+        void setKey(GroupKey key);
+        GroupKey getKey() const { return key; }
+        void clear();
+
+        // Aggregates rows[n, rows.size()), where n is the number of rows seen by previous calls.
+        // rows must only have grown since then; call clear() when the view is rebuilt. Returns false if there was nothing to add.
+        bool update(const LogStats& stats, const std::vector<uint32_t>& rows);
+
+        // Indexed by group key; groups without rows have count == 0.
+        const std::vector<Group>& getGroups() const { return groups; }
+        std::string getLabel(const LogStats& stats, uint32_t group) const;
+
+    private:
+        uint32_t keyOf(const LogDetailNew& d) const;
+        void addNames(const std::unordered_map<std::string, std::shared_ptr<const std::string>>& name_map);
+
+        GroupKey key = GroupKey_Thread;
+        size_t row_count = 0;
+        std::vector<Group> groups;
+        std::vector<const std::string*> names;                      // GroupKey_Thread / GroupKey_File: group key -> name
+        std::unordered_map<const std::string*, uint32_t> name_keys;
+    };
+}
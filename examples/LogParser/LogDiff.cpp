@@ -0,0 +1,213 @@
+#include "LogDiff.h"
+#include "Parallel.h"
+#include <string_view>
+
+namespace LogParser {
+
+    struct DiffKeyAgg {
+        uint64_t count = 0;
+        int64_t first_ts = -1;
+        uint32_t row = 0;       // A row with this key, to build the label from
+    };
+
+    // Rows of one key in one time bucket
+    struct DiffCell {
+        uint64_t key;
+        int64_t bucket;
+        bool operator==(const DiffCell& o) const { return key == o.key && bucket == o.bucket; }
+    };
+
+    struct DiffCellHash {
+        size_t operator()(const DiffCell& c) const { return (size_t)(c.key ^ ((uint64_t)c.bucket * 0x9E3779B97F4A7C15ull)); }
+    };
+
+    // Aggregates of a run, or of a chunk of it
+    struct DiffSide {
+        std::unordered_map<uint64_t, DiffKeyAgg> keys[DiffKey_COUNT];
+        std::unordered_map<DiffCell, uint64_t, DiffCellHash> cells[DiffKey_COUNT];
+    };
+
+    static void get_time_range(const LogStats& stats, int64_t* min_ts, int64_t* max_ts) {
+        *min_ts = *max_ts = -1;
+        for (const LogDetailNew& d : stats.logs) {
+            if (d.ts >= 0) {
+                *min_ts = (*min_ts < 0 || d.ts < *min_ts) ? d.ts : *min_ts;
+                *max_ts = d.ts > *max_ts ? d.ts : *max_ts;
+            }
+        }
+    }
+
+    // Key of a row's template: the hash of its text, so the templates of both runs join on their text. Rows of a
+    // LogStats that wasn't filled by an ImportJob have no template, their masked first line is hashed instead.
+    static uint64_t get_template_key(const std::vector<uint64_t>& template_keys, const LogDetailNew& d, std::string* masked) {
+        if (d.template_id < template_keys.size()) {
+            return template_keys[d.template_id];
+        }
+        mask_message(d.content.data(), d.content.data() + d.first_line_len, masked);
+        return std::hash<std::string_view>()(*masked);
+    }
+
+    static void aggregate_rows(const LogStats& stats, size_t begin, size_t end, int64_t start_ts, int64_t bucket_ms,
+        const std::unordered_map<const std::string*, uint64_t>& thread_keys, const std::vector<uint64_t>& template_keys,
+        DiffSide* out, const std::atomic<bool>* cancel) {
+        const size_t cancel_interval = 64 * 1024;
+        std::string masked;
+        for (size_t row = begin; row < end; row++) {
+            if ((row - begin) % cancel_interval == 0 && cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+                return;
+            }
+            const LogDetailNew& d = stats.logs[row];
+            uint64_t keys[DiffKey_COUNT];
+            keys[DiffKey_Template] = get_template_key(template_keys, d, &masked);
+            keys[DiffKey_Thread] = thread_keys.find(d.thread_name)->second;
+            keys[DiffKey_Level] = d.level;
+            const int64_t bucket = d.ts >= 0 ? (d.ts - start_ts) / bucket_ms : -1;
+            for (int k = 0; k < DiffKey_COUNT; k++) {
+                DiffKeyAgg& agg = out->keys[k][keys[k]];
+                if (agg.count++ == 0) {
+                    agg.row = (uint32_t)row;
+                }
+                if (d.ts >= 0 && (agg.first_ts < 0 || d.ts < agg.first_ts)) {
+                    agg.first_ts = d.ts;
+                }
+                if (bucket >= 0) {
+                    out->cells[k][DiffCell{ keys[k], bucket }]++;
+                }
+            }
+        }
+    }
+
+    static void merge_side(DiffSide* dst, const DiffSide& src) {
+        for (int k = 0; k < DiffKey_COUNT; k++) {
+            for (const auto& kv : src.keys[k]) {
+                DiffKeyAgg& agg = dst->keys[k][kv.first];
+                if (agg.count == 0) {
+                    agg.row = kv.second.row;
+                }
+                agg.count += kv.second.count;
+                if (kv.second.first_ts >= 0 && (agg.first_ts < 0 || kv.second.first_ts < agg.first_ts)) {
+                    agg.first_ts = kv.second.first_ts;
+                }
+            }
+            for (const auto& kv : src.cells[k]) {
+                dst->cells[k][kv.first] += kv.second;
+            }
+        }
+    }
+
+    static void aggregate_run(const LogStats& stats, int64_t start_ts, int64_t bucket_ms, DiffSide* out, const std::atomic<bool>* cancel) {
+        // Thread names and templates are interned per run: hash every one once, the workers only read the keys
+        std::unordered_map<const std::string*, uint64_t> thread_keys;
+        for (const auto& kv : stats.thread_name_map) {
+            thread_keys[kv.second.get()] = std::hash<std::string>()(kv.first);
+        }
+        std::vector<uint64_t> template_keys(stats.templates.size());
+        for (size_t i = 0; i < stats.templates.size(); i++) {
+            template_keys[i] = std::hash<std::string>()(stats.templates[i]);
+        }
+
+        const size_t count = stats.logs.size();
+        const int workers = get_worker_count(count);
+        std::vector<DiffSide> partials(workers);
+        parallel_for_chunks(workers, count, [&](int w, size_t begin, size_t end) {
+            aggregate_rows(stats, begin, end, start_ts, bucket_ms, thread_keys, template_keys, &partials[w], cancel);
+        });
+        *out = std::move(partials[0]);
+        for (int w = 1; w < workers; w++) {
+            merge_side(out, partials[w]);
+        }
+    }
+
+    static std::string get_label(const LogStats& stats, DiffKey key, uint32_t row) {
+        const LogDetailNew& d = stats.logs[row];
+        std::string label;
+        switch (key) {
+        case DiffKey_Template:
+            if (d.template_id < stats.templates.size()) {
+                label = stats.templates[d.template_id];
+            } else {
+                mask_message(d.content.data(), d.content.data() + d.first_line_len, &label);
+            }
+            break;
+        case DiffKey_Thread: label = *d.thread_name; break;
+        case DiffKey_Level: label = get_level_name(d.level); break;
+        default: break;
+        }
+        return label;
+    }
+
+    bool diff_logs(const LogStats& a, const LogStats& b, LogDiff* out, const std::atomic<bool>* cancel) {
+        const LogStats* runs[2] = { &a, &b };
+        int64_t start_ts[2], end_ts[2];
+        int64_t duration = 0;
+        for (int s = 0; s < 2; s++) {
+            get_time_range(*runs[s], &start_ts[s], &end_ts[s]);
+            duration = std::max(duration, end_ts[s] - start_ts[s]);
+        }
+        // About 256 buckets over the longer run, in whole seconds
+        const int64_t bucket_ms = std::max((int64_t)1, (duration / 256 + 999) / 1000) * 1000;
+
+        DiffSide sides[2];
+        for (int s = 0; s < 2; s++) {
+            aggregate_run(*runs[s], start_ts[s], bucket_ms, &sides[s], cancel);
+            if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+
+        *out = LogDiff();
+        out->total[0] = a.logs.size();
+        out->total[1] = b.logs.size();
+        out->bucket_ms = bucket_ms;
+        for (int k = 0; k < DiffKey_COUNT; k++) {
+            std::vector<DiffRow>& rows = out->rows[k];
+            std::unordered_map<uint64_t, size_t> index;
+            for (int s = 0; s < 2; s++) {
+                for (const auto& kv : sides[s].keys[k]) {
+                    auto it = index.emplace(kv.first, rows.size());
+                    if (it.second) {
+                        rows.emplace_back();
+                        rows.back().label = get_label(*runs[s], (DiffKey)k, kv.second.row);
+                    }
+                    DiffRow& row = rows[it.first->second];
+                    row.count[s] = kv.second.count;
+                    row.first_offset_ms[s] = kv.second.first_ts >= 0 ? kv.second.first_ts - start_ts[s] : -1;
+                }
+            }
+
+            // Join the (key, bucket) counts of both runs, a bucket missing on one side counts 0
+            auto update_peak = [&](const DiffCell& cell, int64_t delta) {
+                DiffRow& row = rows[index[cell.key]];
+                const int64_t offset_ms = cell.bucket * bucket_ms;
+                // Ties go to the earliest bucket, hash map order is not stable
+                if (std::abs(delta) > std::abs(row.peak_delta)
+                    || (delta != 0 && std::abs(delta) == std::abs(row.peak_delta) && offset_ms < row.peak_offset_ms)) {
+                    row.peak_delta = delta;
+                    row.peak_offset_ms = offset_ms;
+                }
+            };
+            for (const auto& kv : sides[0].cells[k]) {
+                auto it = sides[1].cells[k].find(kv.first);
+                update_peak(kv.first, (int64_t)(it != sides[1].cells[k].end() ? it->second : 0) - (int64_t)kv.second);
+            }
+            for (const auto& kv : sides[1].cells[k]) {
+                if (sides[0].cells[k].find(kv.first) == sides[0].cells[k].end()) {
+                    update_peak(kv.first, (int64_t)kv.second);
+                }
+            }
+        }
+        return true;
+    }
+
+    DiffJob::DiffJob(const LogStats* a, const LogStats* b) : a(a), b(b) {}
+
+    void DiffJob::start() {
+        job.start([this] { run(); });
+    }
+
+    void DiffJob::run() {
+        const int64_t t0 = now_ns();
+        diff_logs(*a, *b, &result, job.getCancelFlag());
+        seconds = (now_ns() - t0) / 1e9;
+    }
+}
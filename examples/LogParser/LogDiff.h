@@ -0,0 +1,56 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    enum DiffKey {
+        DiffKey_Template,   // Template of the first line (see TemplateClusterer), as in the Patterns tab
+        DiffKey_Thread,
+        DiffKey_Level,
+        DiffKey_COUNT
+    };
+
+    // One template, thread or level, as seen in run A (index 0) and run B (index 1).
+    struct DiffRow {
+        std::string label;
+        uint64_t count[2] = {};
+        int64_t first_offset_ms[2] = { -1, -1 };    // First occurrence, from the start of the run; -1 if none
+        int64_t peak_offset_ms = -1;                // Time bucket, from the start of the runs, where the counts differ the most
+        int64_t peak_delta = 0;                     // Count in B - count in A in that bucket
+    };
+
+    struct LogDiff {
+        std::vector<DiffRow> rows[DiffKey_COUNT];
+        uint64_t total[2] = {};
+        int64_t bucket_ms = 0;
+    };
+
+    // Compares two runs. Rows are keyed on a hash of their template text, thread name or level.
+    // The runs are aligned on their first timestamp and cut in the same time buckets, so the (key, bucket)
+    // counts of both runs can be joined to find when a key diverges. Every worker aggregates a chunk of rows
+    // into its own hash tables, which are merged at the end.
+    // Returns false if cancelled.
+    bool diff_logs(const LogStats& a, const LogStats& b, LogDiff* out, const std::atomic<bool>* cancel = nullptr);
+
+    // diff_logs() on its own thread. a and b must not change until the job is finished or destroyed.
+    class DiffJob {
+    public:
+        DiffJob(const LogStats* a, const LogStats* b);
+
+        void start();
+        void cancel() { job.cancel(); }
+        bool isRunning() const { return job.isRunning(); }
+        bool isCancelled() const { return job.isCancelled(); }
+        double getSeconds() const { return seconds; }
+
+        LogDiff result;     // Only valid once the job is finished
+
+    private:
+        void run();
+
+        const LogStats* a;
+        const LogStats* b;
+        double seconds = 0.0;
+        BackgroundJob job;
+    };
+}
@@ -0,0 +1,108 @@
+#include "LogFilter.h"
+
+namespace LogParser {
+
+    void resetFilter(Filter& filter) {
+        //std::fill(std::begin(filter.str), std::end(filter.str), 0);
+        //std::fill(std::begin(filter.str_raw), std::end(filter.str_raw), 0);
+        //filter.is_case_sensitive = false;
+        filter.pattern_map.clear();
+        filter.is_regex_error = false;
+    }
+
+    void parseFilter(Filter* filter) {
+        resetFilter(*filter);
+        std::string sfilter = std::string(filter->str);
+
+        boost::regex_constants::syntax_option_type flag = boost::regex_constants::perl;
+        if (!filter->is_case_sensitive) {
+            flag |= boost::regex_constants::icase;
+        }
+
+        try {
+            size_t col_name_start = 0, col_name_end = 0, cond_start = 0, cond_end = 0;
+            for (size_t i = 0; i < sfilter.size(); i++) {
+                char c = sfilter[i];
+                if (col_name_end < 1) {
+                    for (; i < sfilter.size() && sfilter[i] == ' '; i++);
+                    col_name_start = i;
+                    for (; i + 1 < sfilter.size() && sfilter[i + 1] != ' ' && sfilter[i + 1] != '='; i++);
+                    col_name_end = i + 1;
+                }
+                else if (cond_start < 1) {
+                    if (c == '"') {
+                        i = i + 1;
+                        cond_start = i;
+                        for (; i < sfilter.size() && sfilter[i] != '"'; i++);
+                        cond_end = i;
+                        std::string k = sfilter.substr(col_name_start, col_name_end - col_name_start);
+                        std::string v = "^.*" + sfilter.substr(cond_start, cond_end - cond_start) + ".*$";
+                        auto pattern = boost::regex(v, flag);
+                        filter->pattern_map[k] = pattern;
+                    }
+                }
+                else if (cond_end > 0) {
+                    if (c == 'A' || c == 'a') {
+                        if (i + 2 < sfilter.size()
+                            && (sfilter[i + 1] == 'N' || sfilter[i + 1] == 'n')
+                            && (sfilter[i + 2] == 'D' || sfilter[i + 2] == 'd')) {
+                            i = i + 3;
+                            for (; i + 1 < sfilter.size() && sfilter[i + 1] == ' '; i++);
+                            col_name_start = i + 1;
+                            col_name_end = 0, cond_start = 0, cond_end = 0;
+                        }
+                    }
+                }
+                for (; i + 1 < sfilter.size() && sfilter[i + 1] == ' '; i++);
+            }
+
+            if (filter->pattern_map.size() == 0) {
+                auto pattern = boost::regex("^.*" + sfilter + ".*$", flag);
+                filter->pattern_map["*"] = pattern;
+            }
+        }
+        catch (const boost::regex_error& e) {
+            std::cerr << "Regex error: " << e.what() << '\n';
+            std::cerr << "Error code: " << e.code() << '\n';
+            filter->is_regex_error = true;
+        }
+
+        filter->is_regex_error = false;
+    }
+
+    bool isLineMatchFilter(const LogDetailNew& info, const Filter& filter, boost::smatch& matches) {
+        auto m = filter.pattern_map;
+        boost::regex* regex_default = nullptr;
+        auto default_it = m.find("*");
+        if (default_it != m.end()) {
+            regex_default = &default_it->second;
+        }
+
+        std::vector <std::pair<std::string, const std::string&>> keys = {
+            {"C1", info.dt},
+            {"C2", info.prority},
+            {"C3", *info.thread_name},
+            {"C4", info.content}
+        };
+
+        if (regex_default == nullptr) {
+            for (const auto& kv : keys) {
+                auto it = m.find(kv.first);
+                if (it != m.end()) {
+                    if (!boost::regex_match(kv.second, matches, it->second)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        else {
+            for (const auto& kv : keys) {
+                if (boost::regex_match(kv.second, matches, *regex_default)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    // Filter expression typed in the Filter / Find boxes: either a single regex matched against every column,
+    // or 'C1="regex" AND C4="regex"' conditions on dt (C1), prority (C2), thread (C3) and content (C4).
+    struct Filter {
+        char str[1024] = { 0 };
+        std::unordered_map<std::string, boost::regex> pattern_map;
+        bool is_case_sensitive = false;
+        bool is_regex_error = false;
+    };
+
+    void resetFilter(Filter& filter);
+    void parseFilter(Filter* filter);
+    bool isLineMatchFilter(const LogDetailNew& info, const Filter& filter, boost::smatch& matches);
+}
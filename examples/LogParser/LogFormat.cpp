@@ -0,0 +1,650 @@
+#include "LogFormat.h"
+#include "LogParser.h"
+#include <cstring>
+
+namespace LogParser {
+
+    static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    static inline bool is_letter(char c) { return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'); }
+    static inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; }
+
+    static inline bool is_digits(const char* p, int count) {
+        for (int i = 0; i < count; i++) {
+            if (!is_digit(p[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline int to_int(const char* p, int count) {
+        int v = 0;
+        for (int i = 0; i < count; i++) {
+            v = v * 10 + (p[i] - '0');
+        }
+        return v;
+    }
+
+    // Milliseconds from up to 3 fraction digits at p, 0 if none. Sets *end after all the digits.
+    static int parse_fraction_ms(const char* p, const char* line_end, const char** end) {
+        int ms = 0;
+        int digits = 0;
+        for (; p < line_end && is_digit(*p); p++, digits++) {
+            if (digits < 3) {
+                ms = ms * 10 + (*p - '0');
+            }
+        }
+        for (; digits < 3; digits++) {
+            ms *= 10;
+        }
+        *end = p;
+        return ms;
+    }
+
+    // Month and day of a day count since 1970-01-01, in the proleptic Gregorian calendar.
+    static void civil_from_days(int64_t days, int* mon, int* day) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t doe = days - era * 146097;
+        const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64_t mp = (5 * doy + 2) / 153;
+        *day = (int)(doy - (153 * mp + 2) / 5 + 1);
+        *mon = (int)(mp < 10 ? mp + 3 : mp - 9);
+    }
+
+    // Timestamp layouts. scan() matches a timestamp at p and returns its end, or nullptr if there is none.
+    // *ts is set to -1 when the timestamp has the right shape but out of range values.
+
+    // \d{2}-\d{2}\s\d{2}:\d{2}:\d{2}\.\d+
+    struct MonthDayTimestamp {
+        static const char* scan(const char* p, const char* line_end, int64_t* ts) {
+            if (line_end - p < 16
+                || !is_digits(p, 2) || p[2] != '-' || !is_digits(p + 3, 2) || !is_space(p[5])
+                || !is_digits(p + 6, 2) || p[8] != ':' || !is_digits(p + 9, 2) || p[11] != ':'
+                || !is_digits(p + 12, 2) || p[14] != '.' || !is_digit(p[15])) {
+                return nullptr;
+            }
+            const char* end = p + 16;
+            while (end < line_end && is_digit(*end)) {
+                end++;
+            }
+            *ts = parse_timestamp(p, end - p);
+            return end;
+        }
+    };
+
+    // \d{4}-\d{2}-\d{2}[T ]\d{2}:\d{2}(:\d{2}([.,]\d+)?)?(Z|[+-]\d{2}(:?\d{2})?)?
+    struct Iso8601Timestamp {
+        static const char* scan(const char* p, const char* line_end, int64_t* ts) {
+            if (line_end - p < 16
+                || !is_digits(p, 4) || p[4] != '-' || !is_digits(p + 5, 2) || p[7] != '-' || !is_digits(p + 8, 2)
+                || (p[10] != 'T' && p[10] != ' ') || !is_digits(p + 11, 2) || p[13] != ':' || !is_digits(p + 14, 2)) {
+                return nullptr;
+            }
+            const char* end = p + 16;
+            int sec = 0;
+            int ms = 0;
+            if (line_end - end >= 3 && end[0] == ':' && is_digits(end + 1, 2)) {
+                sec = to_int(end + 1, 2);
+                end += 3;
+                if (line_end - end >= 2 && (end[0] == '.' || end[0] == ',') && is_digit(end[1])) {
+                    ms = parse_fraction_ms(end + 1, line_end, &end);
+                }
+            }
+            if (end < line_end && *end == 'Z') {
+                end++;
+            }
+            else if (line_end - end >= 3 && (end[0] == '+' || end[0] == '-') && is_digits(end + 1, 2)) {
+                end += 3;
+                if (line_end - end >= 3 && end[0] == ':' && is_digits(end + 1, 2)) {
+                    end += 3;
+                }
+                else if (line_end - end >= 2 && is_digits(end, 2)) {
+                    end += 2;
+                }
+            }
+            *ts = make_timestamp(to_int(p + 5, 2), to_int(p + 8, 2), to_int(p + 11, 2), to_int(p + 14, 2), sec, ms);
+            return end;
+        }
+    };
+
+    // Mmm [ d]d hh:mm:ss
+    struct SyslogTimestamp {
+        static const char* scan(const char* p, const char* line_end, int64_t* ts) {
+            static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+            if (line_end - p < 15 || p[3] != ' ' || (p[4] != ' ' && !is_digit(p[4])) || !is_digit(p[5]) || p[6] != ' '
+                || !is_digits(p + 7, 2) || p[9] != ':' || !is_digits(p + 10, 2) || p[12] != ':' || !is_digits(p + 13, 2)) {
+                return nullptr;
+            }
+            int mon = 0;
+            while (mon < 12 && memcmp(months + mon * 3, p, 3) != 0) {
+                mon++;
+            }
+            if (mon == 12) {
+                return nullptr;
+            }
+            const int day = (p[4] == ' ' ? 0 : p[4] - '0') * 10 + (p[5] - '0');
+            *ts = make_timestamp(mon + 1, day, to_int(p + 7, 2), to_int(p + 10, 2), to_int(p + 13, 2), 0);
+            return p + 15;
+        }
+    };
+
+    // \d{9,}(\.\d+)? seconds since 1970, or milliseconds when the integer part has 12 digits or more
+    struct EpochTimestamp {
+        static const char* scan(const char* p, const char* line_end, int64_t* ts) {
+            const char* end = p;
+            int64_t v = 0;
+            while (end < line_end && is_digit(*end) && end - p < 18) {
+                v = v * 10 + (*end - '0');
+                end++;
+            }
+            const int digits = (int)(end - p);
+            if (digits < 9) {
+                return nullptr;
+            }
+            int64_t ms = v;
+            if (digits < 12) {
+                ms = v * 1000;
+                if (line_end - end >= 2 && end[0] == '.' && is_digit(end[1])) {
+                    ms += parse_fraction_ms(end + 1, line_end, &end);
+                }
+            }
+            else if (line_end - end >= 2 && end[0] == '.' && is_digit(end[1])) {
+                parse_fraction_ms(end + 1, line_end, &end);
+            }
+            const int64_t rem = ms % 86400000;
+            int mon, day;
+            civil_from_days(ms / 86400000, &mon, &day);
+            *ts = make_timestamp(mon, day, (int)(rem / 3600000), (int)(rem / 60000 % 60), (int)(rem / 1000 % 60), (int)(rem % 1000));
+            return end;
+        }
+    };
+
+    typedef LogScanner::Step Step;
+
+    // Matches steps [step, end) at p. A {level}, {thread} or {skip} field ends at the first occurrence of the
+    // character that starts the next step for which the rest of the steps match.
+    template<class TS>
+    static bool match_steps(const Step* step, const Step* end, const char* p, const char* line_end, LogHeader* out) {
+        for (; step != end; step++) {
+            switch (step->kind) {
+            case LogScanner::StepKind_Text:
+                if ((size_t)(line_end - p) < step->text.size() || memcmp(p, step->text.data(), step->text.size()) != 0) {
+                    return false;
+                }
+                p += step->text.size();
+                break;
+            case LogScanner::StepKind_Spaces:
+                if (p == line_end || *p != ' ') {
+                    return false;
+                }
+                while (p < line_end && *p == ' ') {
+                    p++;
+                }
+                break;
+            case LogScanner::StepKind_Time: {
+                const char* time_end = TS::scan(p, line_end, &out->ts);
+                if (time_end == nullptr) {
+                    return false;
+                }
+                out->time = std::string_view(p, time_end - p);
+                p = time_end;
+                break;
+            }
+            case LogScanner::StepKind_Message:
+                out->message = std::string_view(p, line_end - p);
+                p = line_end;
+                break;
+            default: {
+                // Followed by a text or spaces step, checked by LogScanner::compile()
+                const Step* next = step + 1;
+                const char delimiter = next->kind == LogScanner::StepKind_Text ? next->text[0] : ' ';
+                const char* search_end = line_end;
+                if (step->kind == LogScanner::StepKind_Level) {
+                    const char* letters_end = p;
+                    while (letters_end < line_end && is_letter(*letters_end)) {
+                        letters_end++;
+                    }
+                    search_end = letters_end < line_end ? letters_end + 1 : line_end;
+                }
+                for (const char* q = p + 1; q < search_end; q++) {
+                    q = (const char*)memchr(q, delimiter, search_end - q);
+                    if (q == nullptr) {
+                        return false;
+                    }
+                    const std::string_view field(p, q - p);
+                    if (step->kind == LogScanner::StepKind_Level) {
+                        out->level = field;
+                    }
+                    else if (step->kind == LogScanner::StepKind_Thread) {
+                        out->thread = field;
+                    }
+                    if (match_steps<TS>(next, end, q, line_end, out)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            }
+        }
+        return p == line_end;
+    }
+
+    template<class TS>
+    static bool scan_steps(const std::vector<Step>& steps, std::string_view line, LogHeader* out) {
+        *out = LogHeader();
+        return match_steps<TS>(steps.data(), steps.data() + steps.size(), line.data(), line.data() + line.size(), out);
+    }
+
+    static const char* const NativePattern = "[{level} {thread},{time}]:{message}";
+
+    // Characters allowed in a thread name by the original header regex
+    struct NativeThreadChars {
+        bool table[256] = {};
+        NativeThreadChars() {
+            for (const char* c = "_-!@#$%^&*()+|<?.:=[]/, \t\n\v\f\r"; *c; c++) {
+                table[(unsigned char)*c] = true;
+            }
+            for (int c = 0; c < 256; c++) {
+                table[c] |= is_letter((char)c) || is_digit((char)c);
+            }
+        }
+    };
+
+    // NativePattern, matched exactly like the regex it replaces:
+    // ^\[([A-Z]{3}) ([A-Za-z0-9\s_\-!@#$%^&*()_+|<?.:=\[\]/,]+?),(\d{2}-\d{2}\s\d{2}:\d{2}:\d{2}\.\d+)\]:(.*)$
+    static bool scan_native(const std::vector<Step>&, std::string_view line, LogHeader* out) {
+        static const NativeThreadChars thread_chars;
+        *out = LogHeader();
+        const char* p = line.data();
+        const char* end = p + line.size();
+        if (end - p < 6 || p[0] != '[' || p[1] < 'A' || p[1] > 'Z' || p[2] < 'A' || p[2] > 'Z' || p[3] < 'A' || p[3] > 'Z' || p[4] != ' ') {
+            return false;
+        }
+        // Shortest thread name followed by a timestamp and "]:"
+        const char* thread = p + 5;
+        for (const char* q = thread; q < end && thread_chars.table[(unsigned char)*q]; q++) {
+            if (*q != ',' || q == thread) {
+                continue;
+            }
+            const char* time_end = MonthDayTimestamp::scan(q + 1, end, &out->ts);
+            if (time_end != nullptr && end - time_end >= 2 && time_end[0] == ']' && time_end[1] == ':') {
+                out->level = std::string_view(p + 1, 3);
+                out->thread = std::string_view(thread, q - thread);
+                out->time = std::string_view(q + 1, time_end - q - 1);
+                out->message = std::string_view(time_end + 2, end - time_end - 2);
+                return true;
+            }
+        }
+        out->ts = -1;
+        return false;
+    }
+
+    enum JsonKey {
+        JsonKey_None,
+        JsonKey_Level,
+        JsonKey_Thread,
+        JsonKey_Time,
+        JsonKey_Message,
+        JsonKey_COUNT
+    };
+
+    // Key names per field, by priority: "thread" wins over "logger" when a line has both.
+    static JsonKey get_json_key(std::string_view name, int* rank) {
+        static const struct { const char* name; JsonKey key; } keys[] = {
+            { "level", JsonKey_Level }, { "severity", JsonKey_Level }, { "lvl", JsonKey_Level }, { "loglevel", JsonKey_Level }, { "log.level", JsonKey_Level },
+            { "thread", JsonKey_Thread }, { "thread_name", JsonKey_Thread }, { "threadName", JsonKey_Thread }, { "logger", JsonKey_Thread }, { "logger_name", JsonKey_Thread }, { "component", JsonKey_Thread },
+            { "time", JsonKey_Time }, { "timestamp", JsonKey_Time }, { "ts", JsonKey_Time }, { "@timestamp", JsonKey_Time }, { "datetime", JsonKey_Time },
+            { "msg", JsonKey_Message }, { "message", JsonKey_Message }, { "@message", JsonKey_Message },
+        };
+        for (int i = 0; i < (int)(sizeof(keys) / sizeof(keys[0])); i++) {
+            if (name == keys[i].name) {
+                *rank = i;
+                return keys[i].key;
+            }
+        }
+        return JsonKey_None;
+    }
+
+    static inline const char* skip_json_spaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+            p++;
+        }
+        return p;
+    }
+
+    // p is on the opening quote. Returns the end of the string after the closing quote, or nullptr.
+    static const char* scan_json_string(const char* p, const char* end, std::string_view* out, bool* has_escapes) {
+        const char* begin = ++p;
+        *has_escapes = false;
+        while (p < end && *p != '"') {
+            if (*p == '\\') {
+                *has_escapes = true;
+                p++;
+            }
+            p++;
+        }
+        if (p >= end) {
+            return nullptr;
+        }
+        *out = std::string_view(begin, p - begin);
+        return p + 1;
+    }
+
+    // Skips an object or array, p is on its opening bracket.
+    static const char* skip_json_container(const char* p, const char* end) {
+        int depth = 0;
+        while (p < end) {
+            if (*p == '"') {
+                std::string_view s;
+                bool has_escapes;
+                p = scan_json_string(p, end, &s, &has_escapes);
+                if (p == nullptr) {
+                    return nullptr;
+                }
+                continue;
+            }
+            if (*p == '{' || *p == '[') {
+                depth++;
+            }
+            else if ((*p == '}' || *p == ']') && --depth == 0) {
+                return p + 1;
+            }
+            p++;
+        }
+        return nullptr;
+    }
+
+    static void append_utf8(uint32_t cp, std::string* out) {
+        if (cp < 0x80) {
+            out->push_back((char)cp);
+        }
+        else if (cp < 0x800) {
+            out->push_back((char)(0xC0 | (cp >> 6)));
+            out->push_back((char)(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000) {
+            out->push_back((char)(0xE0 | (cp >> 12)));
+            out->push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+            out->push_back((char)(0x80 | (cp & 0x3F)));
+        }
+        else {
+            out->push_back((char)(0xF0 | (cp >> 18)));
+            out->push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+            out->push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+            out->push_back((char)(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    static bool parse_hex4(const char* p, const char* end, uint32_t* out) {
+        if (end - p < 4) {
+            return false;
+        }
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            const char c = p[i];
+            v <<= 4;
+            if (c >= '0' && c <= '9') v |= c - '0';
+            else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+            else return false;
+        }
+        *out = v;
+        return true;
+    }
+
+    static void unescape_json_string(std::string_view s, std::string* out) {
+        out->clear();
+        out->reserve(s.size());
+        const char* end = s.data() + s.size();
+        for (const char* p = s.data(); p < end; p++) {
+            if (*p != '\\' || p + 1 == end) {
+                out->push_back(*p);
+                continue;
+            }
+            p++;
+            switch (*p) {
+            case 'n': out->push_back('\n'); break;
+            case 't': out->push_back('\t'); break;
+            case 'r': out->push_back('\r'); break;
+            case 'b': out->push_back('\b'); break;
+            case 'f': out->push_back('\f'); break;
+            case 'u': {
+                uint32_t cp;
+                if (!parse_hex4(p + 1, end, &cp)) {
+                    out->push_back('u');
+                    break;
+                }
+                p += 4;
+                uint32_t low;
+                if (cp >= 0xD800 && cp < 0xDC00 && end - p > 2 && p[1] == '\\' && p[2] == 'u' && parse_hex4(p + 3, end, &low) && low >= 0xDC00 && low < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                }
+                append_utf8(cp, out);
+                break;
+            }
+            default: out->push_back(*p); break;
+            }
+        }
+    }
+
+    // Numeric levels of pino and bunyan
+    static std::string_view get_numeric_level_name(std::string_view value) {
+        int v = 0;
+        for (char c : value) {
+            if (!is_digit(c)) {
+                return value;
+            }
+            v = v * 10 + (c - '0');
+        }
+        return v >= 50 ? "error" : v >= 40 ? "warn" : v >= 30 ? "info" : "debug";
+    }
+
+    // One flat pass over the object: nested values are skipped, the fields are picked by key name.
+    static bool scan_json(const std::vector<Step>&, std::string_view line, LogHeader* out) {
+        *out = LogHeader();
+        const char* end = line.data() + line.size();
+        const char* p = skip_json_spaces(line.data(), end);
+        if (p == end || *p != '{') {
+            return false;
+        }
+        p = skip_json_spaces(p + 1, end);
+        int ranks[JsonKey_COUNT] = { 0, INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX };
+        std::string_view message;
+        bool message_escaped = false;
+        bool time_is_string = false;
+        while (p < end && *p != '}') {
+            std::string_view name, value;
+            bool has_escapes = false;
+            if (*p != '"' || (p = scan_json_string(p, end, &name, &has_escapes)) == nullptr) {
+                return false;
+            }
+            p = skip_json_spaces(p, end);
+            if (p == end || *p != ':') {
+                return false;
+            }
+            p = skip_json_spaces(p + 1, end);
+            if (p == end) {
+                return false;
+            }
+            const bool is_string = *p == '"';
+            if (is_string) {
+                p = scan_json_string(p, end, &value, &has_escapes);
+            }
+            else if (*p == '{' || *p == '[') {
+                p = skip_json_container(p, end);
+            }
+            else {
+                const char* value_begin = p;
+                while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t') {
+                    p++;
+                }
+                value = std::string_view(value_begin, p - value_begin);
+            }
+            if (p == nullptr) {
+                return false;
+            }
+
+            int rank;
+            const JsonKey key = get_json_key(name, &rank);
+            if (key != JsonKey_None && !value.empty() && rank < ranks[key]) {
+                ranks[key] = rank;
+                switch (key) {
+                case JsonKey_Level: out->level = is_string ? value : get_numeric_level_name(value); break;
+                case JsonKey_Thread: out->thread = value; break;
+                case JsonKey_Time: out->time = value; time_is_string = is_string; break;
+                case JsonKey_Message: message = value; message_escaped = has_escapes; break;
+                default: break;
+                }
+            }
+
+            p = skip_json_spaces(p, end);
+            if (p < end && *p == ',') {
+                p = skip_json_spaces(p + 1, end);
+            }
+        }
+        if (p == end || (out->time.empty() && message.empty())) {
+            return false;
+        }
+
+        if (!out->time.empty()) {
+            const char* time_begin = out->time.data();
+            const char* time_end = time_begin + out->time.size();
+            if (!time_is_string || Iso8601Timestamp::scan(time_begin, time_end, &out->ts) == nullptr) {
+                EpochTimestamp::scan(time_begin, time_end, &out->ts);
+            }
+        }
+        if (message_escaped) {
+            unescape_json_string(message, &out->message_buf);
+            out->message = out->message_buf;
+        }
+        else {
+            out->message = message;
+        }
+        return true;
+    }
+
+    bool LogScanner::compile(const LogFormat& format, std::string* error) {
+        name = format.name;
+        steps.clear();
+        scan_fn = nullptr;
+        auto fail = [&](const std::string& message) {
+            if (error != nullptr) {
+                *error = message;
+            }
+            steps.clear();
+            return false;
+        };
+
+        if (format.pattern == "json") {
+            scan_fn = &scan_json;
+            return true;
+        }
+
+        static const struct { const char* name; StepKind kind; } fields[] = {
+            { "level", StepKind_Level }, { "thread", StepKind_Thread }, { "skip", StepKind_Skip },
+            { "time", StepKind_Time }, { "message", StepKind_Message },
+        };
+        const std::string& pattern = format.pattern;
+        bool has_field = false;
+        bool seen[StepKind_Message + 1] = {};
+        for (size_t i = 0; i < pattern.size();) {
+            if (pattern[i] == '{') {
+                const size_t close = pattern.find('}', i);
+                if (close == std::string::npos) {
+                    return fail("Missing '}'");
+                }
+                const std::string field = pattern.substr(i + 1, close - i - 1);
+                int f = 0;
+                while (f < (int)(sizeof(fields) / sizeof(fields[0])) && field != fields[f].name) {
+                    f++;
+                }
+                if (f == (int)(sizeof(fields) / sizeof(fields[0]))) {
+                    return fail("Unknown field {" + field + "}");
+                }
+                if (fields[f].kind != StepKind_Skip && seen[fields[f].kind]) {
+                    return fail("{" + field + "} appears twice");
+                }
+                seen[fields[f].kind] = true;
+                has_field = true;
+                steps.push_back({ fields[f].kind, std::string() });
+                i = close + 1;
+            }
+            else if (pattern[i] == ' ') {
+                while (i < pattern.size() && pattern[i] == ' ') {
+                    i++;
+                }
+                steps.push_back({ StepKind_Spaces, std::string() });
+            }
+            else {
+                const size_t text_end = pattern.find_first_of("{ ", i);
+                const size_t len = (text_end == std::string::npos ? pattern.size() : text_end) - i;
+                steps.push_back({ StepKind_Text, pattern.substr(i, len) });
+                i += len;
+            }
+        }
+        if (!has_field) {
+            return fail("The pattern has no field");
+        }
+        for (size_t i = 0; i < steps.size(); i++) {
+            const StepKind kind = steps[i].kind;
+            if (kind == StepKind_Message && i + 1 != steps.size()) {
+                return fail("{message} must be the last field");
+            }
+            if ((kind == StepKind_Level || kind == StepKind_Thread || kind == StepKind_Skip)
+                && (i + 1 == steps.size() || (steps[i + 1].kind != StepKind_Text && steps[i + 1].kind != StepKind_Spaces))) {
+                return fail("{level}, {thread} and {skip} must be followed by some text");
+            }
+        }
+
+        switch (format.timestamp_layout) {
+        case TimestampLayout_MonthDay: scan_fn = pattern == NativePattern ? &scan_native : &scan_steps<MonthDayTimestamp>; break;
+        case TimestampLayout_Iso8601: scan_fn = &scan_steps<Iso8601Timestamp>; break;
+        case TimestampLayout_Syslog: scan_fn = &scan_steps<SyslogTimestamp>; break;
+        case TimestampLayout_Epoch: scan_fn = &scan_steps<EpochTimestamp>; break;
+        default: return fail("Unknown timestamp layout");
+        }
+        return true;
+    }
+
+    const std::vector<LogFormat>& get_builtin_log_formats() {
+        // More specific patterns first: detection keeps the first of equally good formats
+        static const std::vector<LogFormat> formats = {
+            { "Native", NativePattern, TimestampLayout_MonthDay },
+            { "ISO 8601 [thread] level", "{time} [{thread}] {level} {message}", TimestampLayout_Iso8601 },
+            { "ISO 8601 level [thread]", "{time} {level} [{thread}] {message}", TimestampLayout_Iso8601 },
+            { "ISO 8601 level", "{time} {level} {message}", TimestampLayout_Iso8601 },
+            { "Syslog", "{time} {skip} {thread}: {message}", TimestampLayout_Syslog },
+            { "JSON lines", "json", TimestampLayout_Iso8601 },
+        };
+        return formats;
+    }
+
+    const char* get_timestamp_layout_name(TimestampLayout layout) {
+        static const char* names[TimestampLayout_COUNT] = { "MM-DD hh:mm:ss.fff", "ISO 8601", "Syslog (Mmm dd hh:mm:ss)", "Unix epoch" };
+        return layout < TimestampLayout_COUNT ? names[layout] : "";
+    }
+
+    size_t detect_log_format(const std::vector<LogFormat>& formats, const std::vector<std::string>& lines) {
+        size_t best = 0;
+        size_t best_count = 0;
+        LogHeader header;
+        for (size_t f = 0; f < formats.size(); f++) {
+            LogScanner scanner;
+            if (!scanner.compile(formats[f])) {
+                continue;
+            }
+            size_t count = 0;
+            for (const std::string& line : lines) {
+                count += scanner.scan(line, &header);
+            }
+            if (count > best_count) {
+                best = f;
+                best_count = count;
+            }
+        }
+        return best;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace LogParser {
+
+    enum TimestampLayout {
+        TimestampLayout_MonthDay,   // "03-08 12:00:01.123"
+        TimestampLayout_Iso8601,    // "2024-03-08T12:00:01.123+01:00", or a space before the time, a ',' before the fraction,
+                                    // no seconds, fraction or zone
+        TimestampLayout_Syslog,     // "Mar  8 12:00:01"
+        TimestampLayout_Epoch,      // "1709899201.123" in seconds, or in milliseconds from 12 digits on
+        TimestampLayout_COUNT
+    };
+
+    // Layout of the header line that starts a record; lines that don't match it are continuation lines.
+    // pattern lists the fields of the line, in order, with the text between them:
+    //   {level}     letters
+    //   {thread}    anything, up to the first text that lets the rest of the line match
+    //   {skip}      same as {thread}, but not kept
+    //   {time}      a timestamp in timestamp_layout
+    //   {message}   the rest of the line, must be the last field
+    // {level}, {thread} and {skip} must be followed by some text. A space matches one or more spaces.
+    // The pattern "json" reads one JSON object per line instead, from the usual key names ("time", "ts",
+    // "level", "msg", ... see JsonKey in LogFormat.cpp).
+    // Timestamps keep their month, day and time of day only (see LogDetailNew::ts), time zones are ignored.
+    struct LogFormat {
+        std::string name;
+        std::string pattern;
+        TimestampLayout timestamp_layout = TimestampLayout_MonthDay;
+    };
+
+    // Fields of a header line. They point into the line, except message for a JSON string with escapes.
+    struct LogHeader {
+        std::string_view level, thread, time, message;
+        int64_t ts = -1;            // See LogDetailNew::ts
+        std::string message_buf;    // Unescaped JSON message
+    };
+
+    // A LogFormat compiled once per file into the matcher for its timestamp layout, so the loader neither parses
+    // the pattern nor dispatches on the layout per line. Fields are matched by scanning for the text that
+    // follows them, backtracking only when the rest of the line doesn't match (like a lazy regex group would).
+    // The native format gets a hand-unrolled matcher that accepts exactly the lines the old header regex did.
+    class LogScanner {
+    public:
+        // Returns false, and sets error if given, when the pattern is invalid.
+        bool compile(const LogFormat& format, std::string* error = nullptr);
+        bool scan(std::string_view line, LogHeader* out) const { return scan_fn(steps, line, out); }
+        const std::string& getName() const { return name; }
+
+        enum StepKind {
+            StepKind_Text,
+            StepKind_Spaces,
+            StepKind_Level,
+            StepKind_Thread,
+            StepKind_Skip,
+            StepKind_Time,
+            StepKind_Message,
+        };
+
+        struct Step {
+            StepKind kind;
+            std::string text;       // StepKind_Text
+        };
+
+    private:
+        typedef bool (*ScanFn)(const std::vector<Step>& steps, std::string_view line, LogHeader* out);
+
+        std::string name;
+        std::vector<Step> steps;
+        ScanFn scan_fn = nullptr;
+    };
+
+    // The native format first, then ISO 8601, syslog and JSON lines layouts.
+    const std::vector<LogFormat>& get_builtin_log_formats();
+    const char* get_timestamp_layout_name(TimestampLayout layout);
+
+    // Index of the format that matches the most lines (the first one on ties, or if none matches any line).
+    size_t detect_log_format(const std::vector<LogFormat>& formats, const std::vector<std::string>& lines);
+}
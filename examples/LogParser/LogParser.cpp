@@ -1,9 +1,9 @@
 #include "LogParser.h"
+#include <chrono>
+#include <filesystem>
 
 namespace LogParser {
 
-    const boost::regex pat(R"(^\[([A-Z]{3}) ([A-Za-z0-9\s_\-!@#$%^&*()_+|<?.:=\[\]/,]+?),(\d{2}-\d{2}\s\d{2}:\d{2}:\d{2}\.\d+)\]:(.*)$)");
-
     const LogStats load_logs_new() {
         std::vector<std::string> paths;
         for (int i = 55; i < 57; i++) {
@@ -12,62 +12,190 @@ namespace LogParser {
             std::string path = std::string(p);
             paths.push_back(path);
         }
-        int progress = 0;
-        LogParser::LoadFileStats stats = {};
+        LogParser::LoadFileStats stats;
         return load_files_new(paths, &stats);
     }
 
-    const LogStats load_files_new(const std::vector<std::string>& const paths, LogParser::LoadFileStats* stats) {
-        stats->loading = true;
+    const LogStats load_files_new(const std::vector<std::string>& paths, LogParser::LoadFileStats* stats, const LoadFileSink* sink, const LogFormat* format) {
+        int64_t total_bytes = 0;
+        for (const std::string& path : paths) {
+            std::error_code ec;
+            uintmax_t size = std::filesystem::file_size(path, ec);
+            if (!ec) {
+                total_bytes += (int64_t)size;
+            }
+        }
+
         stats->cur_file_count = 0;
-        stats->total_file_count = paths.size();
+        stats->total_file_count = (int)paths.size();
+        stats->total_bytes = total_bytes;
+        stats->bytes_read = 0;
+        stats->lines_parsed = 0;
+        stats->records_emitted = 0;
+        stats->read_ns = 0;
+        stats->parse_ns = 0;
+        stats->emit_ns = 0;
+        stats->start_ns = now_ns();
+        stats->end_ns = 0;
+        stats->loading = true;
+
         long id = 0;
         LogStats stat{};
-        for (std::string path : paths) {
+        for (const std::string& path : paths) {
+            if (sink != nullptr && sink->cancel != nullptr && sink->cancel->load(std::memory_order_relaxed)) {
+                break;
+            }
             stats->cur_file_count += 1;
-            stats->cur_file_name = getFileName(path);
-            load_file_new(&id, &path, &stat);
+            stats->setCurFileName(getFileName(path));
+            load_file_new(&id, &path, &stat, stats, sink, format);
         }
-        stats->loading = false;
+        stats->end_ns = now_ns();
+        stats->loading.store(false, std::memory_order_release);
         return stat;
     }
-    const void load_file_new(long* id, const std::string* path, LogStats* stats) {
+
+    // Counters accumulated locally by the loader and flushed to LoadFileStats every few thousand lines,
+    // so the hot loop does not hammer the cache lines the UI thread is reading.
+    // Only the batch as a whole is timed; the read/parse/emit split is measured on 1 line in TimingSampleLines
+    // and scaled to the batch time on flush, so most lines never read the clock.
+    struct LoadFileCounters {
+        static const int64_t TimingSampleLines = 64;
+
+        int64_t bytes_read = 0;
+        int64_t lines_parsed = 0;
+        int64_t records_emitted = 0;
+        int64_t parse_ns = 0;           // Timed outside of the line loop (format detection), not scaled
+        int64_t sample_read_ns = 0;     // Stage timings of the sampled lines
+        int64_t sample_parse_ns = 0;
+        int64_t sample_emit_ns = 0;
+        int64_t batch_start_ns = 0;
+
+        void flush(LoadFileStats* stats) {
+            const int64_t batch_end_ns = now_ns();
+            if (stats != nullptr) {
+                int64_t read_ns = 0, emit_ns = 0;
+                const int64_t sampled_ns = sample_read_ns + sample_parse_ns + sample_emit_ns;
+                if (sampled_ns > 0) {
+                    const double scale = (double)(batch_end_ns - batch_start_ns) / (double)sampled_ns;
+                    read_ns = (int64_t)(sample_read_ns * scale);
+                    parse_ns += (int64_t)(sample_parse_ns * scale);
+                    emit_ns = (int64_t)(sample_emit_ns * scale);
+                }
+                stats->bytes_read.fetch_add(bytes_read, std::memory_order_relaxed);
+                stats->lines_parsed.fetch_add(lines_parsed, std::memory_order_relaxed);
+                stats->records_emitted.fetch_add(records_emitted, std::memory_order_relaxed);
+                stats->read_ns.fetch_add(read_ns, std::memory_order_relaxed);
+                stats->parse_ns.fetch_add(parse_ns, std::memory_order_relaxed);
+                stats->emit_ns.fetch_add(emit_ns, std::memory_order_relaxed);
+            }
+            *this = {};
+            batch_start_ns = batch_end_ns;
+        }
+    };
+
+    // Keeps what Export needs to write the header line of d as it was. Native headers are rebuilt exactly from the
+    // fields, so nothing is stored for them.
+    static void set_raw_prefix(LogDetailNew* d, std::string_view line, const LogHeader& header) {
+        const char* message = header.message.data();
+        if (message < line.data() || message + header.message.size() != line.data() + line.size()) {
+            // JSON lines: the message is not the rest of the line
+            d->raw_prefix.assign(line.data(), line.size());
+            d->raw_content_skip = (uint32_t)header.message.size();
+            return;
+        }
+        const size_t prefix_len = message - line.data();
+        size_t pos = 0;
+        auto expect = [&](std::string_view s) {
+            const bool ok = line.compare(pos, s.size(), s) == 0;
+            pos += s.size();
+            return ok;
+        };
+        if (expect("[") && expect(header.level) && expect(" ") && expect(header.thread) && expect(",") && expect(header.time) && expect("]:") && pos == prefix_len) {
+            return;
+        }
+        d->raw_prefix.assign(line.data(), prefix_len);
+    }
+
+    const void load_file_new(long* id, const std::string* path, LogStats* stats, LoadFileStats* load_stats, const LoadFileSink* sink, const LogFormat* format) {
         std::ifstream file(*path);
         if (!file.is_open()) {
             std::cout << "Failed to open the file." << std::endl;
             return;
         }
 
+        const int64_t flush_interval = 4096;
+        LoadFileCounters counters;
         std::string line;
-        boost::smatch matches;
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line, matches, pat)) {
-                if (matches.size() == 5) {
-                    struct LogDetailNew d = {};
-                    d.id = *id;
-                    d.prority = matches[1];
-                    d.dt = matches[3];
-                    d.content = matches[4];
-
-                    std::string thread_name = matches[2];
-
-                    auto it = stats->thread_name_map.find(thread_name);
-                    if (it == stats->thread_name_map.end()) {
-                        stats->thread_name_map[thread_name] = std::make_shared<const std::string>(thread_name);
-                        it = stats->thread_name_map.find(thread_name);
-                    }
-                    d.thread_name = it->second.get();
-
-                    auto it1 = stats->file_name_map.find(*path);
-                    if (it1 == stats->file_name_map.end()) {
-                        stats->file_name_map[*path] = std::make_shared<const std::string>(*path);
-                        it1 = stats->file_name_map.find(*path);
-                    }
-                    d.file_name = it1->second.get();
-
-                    stats->logs.push_back(d);
-                    *id = *id + 1;
+
+        // The sampled lines are parsed again below, like any other line
+        std::vector<std::string> sample;
+        LogScanner scanner;
+        const int64_t detect_start_ns = now_ns();
+        if (format == nullptr || !scanner.compile(*format)) {
+            while (sample.size() < DetectSampleLines && std::getline(file, line)) {
+                sample.push_back(line);
+            }
+            const std::vector<LogFormat>& formats = get_builtin_log_formats();
+            scanner.compile(formats[detect_log_format(formats, sample)]);
+            counters.parse_ns += now_ns() - detect_start_ns;
+        }
+        if (load_stats != nullptr) {
+            load_stats->setCurFormatName(scanner.getName());
+        }
+
+        size_t sample_i = 0;
+        LogHeader header;
+        counters.batch_start_ns = now_ns();
+        int64_t t0 = counters.batch_start_ns;   // Start of this line's read when it is a timed one, 0 otherwise
+        while (sample_i < sample.size() ? (line.swap(sample[sample_i++]), true) : (bool)std::getline(file, line)) {
+            int64_t t1 = 0, t2 = 0;
+            if (t0 != 0) {
+                t1 = now_ns();
+                counters.sample_read_ns += t1 - t0;
+            }
+            counters.bytes_read += (int64_t)line.size() + 1;
+            counters.lines_parsed++;
+
+            bool is_header = scanner.scan(line, &header);
+            if (t0 != 0) {
+                t2 = now_ns();
+                counters.sample_parse_ns += t2 - t1;
+            }
+
+            if (is_header) {
+                // A new header completes the previous record, so everything buffered so far can be handed off
+                if (sink != nullptr && stats->logs.size() >= sink->batch_size) {
+                    sink->on_batch(stats);
+                }
+                struct LogDetailNew d = {};
+                d.id = *id;
+                d.prority = header.level;
+                d.dt = header.time;
+                d.content = header.message;
+                d.ts = header.ts;
+                d.first_line_len = (uint32_t)std::min(d.content.find('\n'), d.content.size());
+                d.level = parse_level(d.prority);
+                set_raw_prefix(&d, line, header);
+
+                std::string thread_name(header.thread);
+
+                auto it = stats->thread_name_map.find(thread_name);
+                if (it == stats->thread_name_map.end()) {
+                    stats->thread_name_map[thread_name] = std::make_shared<const std::string>(thread_name);
+                    it = stats->thread_name_map.find(thread_name);
+                }
+                d.thread_name = it->second.get();
+
+                auto it1 = stats->file_name_map.find(*path);
+                if (it1 == stats->file_name_map.end()) {
+                    stats->file_name_map[*path] = std::make_shared<const std::string>(*path);
+                    it1 = stats->file_name_map.find(*path);
                 }
+                d.file_name = it1->second.get();
+
+                stats->logs.push_back(d);
+                *id = *id + 1;
+                counters.records_emitted++;
             }
             else {
                 if (stats->logs.size() > 0) {
@@ -75,11 +203,239 @@ namespace LogParser {
                     lastItem->content = lastItem->content + "\n" + line;
                 }
             }
+
+            if (t0 != 0) {
+                counters.sample_emit_ns += now_ns() - t2;
+            }
+            if (counters.lines_parsed >= flush_interval) {
+                counters.flush(load_stats);
+                if (sink != nullptr && sink->cancel != nullptr && sink->cancel->load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            t0 = (counters.lines_parsed % LoadFileCounters::TimingSampleLines) == 0 ? now_ns() : 0;
+        }
+        counters.flush(load_stats);
+        if (sink != nullptr && stats->logs.size() > 0) {
+            sink->on_batch(stats);
         }
 
         file.close();
     }
 
+    void append_batch(LogStats* stats, const LogBatch& batch) {
+        for (const auto& kv : batch.new_thread_names) {
+            stats->thread_name_map.emplace(kv.first, kv.second);
+        }
+        for (const auto& kv : batch.new_file_names) {
+            stats->file_name_map.emplace(kv.first, kv.second);
+        }
+        for (const auto& kv : batch.changed_templates) {
+            if (kv.first >= stats->templates.size()) {
+                stats->templates.resize(kv.first + 1);
+            }
+            stats->templates[kv.first] = kv.second;
+        }
+        stats->logs.insert(stats->logs.end(), batch.logs.begin(), batch.logs.end());
+    }
+
+    LogLevel parse_level(std::string_view s) {
+        static const struct { const char* name; LogLevel level; } names[] = {
+            { "ERR", LogLevel_Err }, { "FTL", LogLevel_Err }, { "CRT", LogLevel_Err }, { "ERROR", LogLevel_Err }, { "FATAL", LogLevel_Err },
+            { "CRIT", LogLevel_Err }, { "CRITICAL", LogLevel_Err }, { "SEVERE", LogLevel_Err }, { "ALERT", LogLevel_Err }, { "EMERG", LogLevel_Err },
+            { "WRN", LogLevel_Wrn }, { "WARN", LogLevel_Wrn }, { "WARNING", LogLevel_Wrn },
+            { "INF", LogLevel_Inf }, { "INFO", LogLevel_Inf }, { "NOTICE", LogLevel_Inf },
+            { "DBG", LogLevel_Dbg }, { "TRC", LogLevel_Dbg }, { "DEBUG", LogLevel_Dbg }, { "TRACE", LogLevel_Dbg }, { "VERBOSE", LogLevel_Dbg },
+        };
+        char upper[9];
+        if (s.empty() || s.size() >= sizeof(upper)) {
+            return LogLevel_Other;
+        }
+        for (size_t i = 0; i < s.size(); i++) {
+            upper[i] = (s[i] >= 'a' && s[i] <= 'z') ? s[i] - 'a' + 'A' : s[i];
+        }
+        const std::string_view key(upper, s.size());
+        for (const auto& n : names) {
+            if (key == n.name) {
+                return n.level;
+            }
+        }
+        return LogLevel_Other;
+    }
+
+    const char* get_level_name(LogLevel level) {
+        static const char* names[LogLevel_COUNT] = { "ERR", "WRN", "INF", "DBG", "Other" };
+        return level < LogLevel_COUNT ? names[level] : "";
+    }
+
+    // Cumulative days before each month. The header carries no year, so Feb is always given 29 days:
+    // timestamps stay monotonic across a leap day and a missing Feb 29 only leaves a one-day hole.
+    static const int days_before_month[12] = { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 };
+
+    static bool parse_digits(const char* s, int count, int* out) {
+        int v = 0;
+        for (int i = 0; i < count; i++) {
+            if (s[i] < '0' || s[i] > '9') {
+                return false;
+            }
+            v = v * 10 + (s[i] - '0');
+        }
+        *out = v;
+        return true;
+    }
+
+    // "MM-DD hh:mm:ss.fff" (any number of fraction digits) -> milliseconds since Jan 1 00:00.
+    int64_t parse_timestamp(const std::string& dt) {
+        return parse_timestamp(dt.data(), dt.size());
+    }
+
+    int64_t parse_timestamp(const char* s, size_t len) {
+        int mon, day, h, m, sec;
+        if (len < 14
+            || !parse_digits(s, 2, &mon) || s[2] != '-' || !parse_digits(s + 3, 2, &day) || s[5] != ' '
+            || !parse_digits(s + 6, 2, &h) || s[8] != ':' || !parse_digits(s + 9, 2, &m) || s[11] != ':'
+            || !parse_digits(s + 12, 2, &sec)
+            || mon < 1 || mon > 12 || day < 1) {
+            return -1;
+        }
+        int ms = 0;
+        if (len > 15 && s[14] == '.') {
+            int digits = 0;
+            for (size_t i = 15; i < len && digits < 3 && s[i] >= '0' && s[i] <= '9'; i++, digits++) {
+                ms = ms * 10 + (s[i] - '0');
+            }
+            for (; digits < 3; digits++) {
+                ms *= 10;
+            }
+        }
+        return make_timestamp(mon, day, h, m, sec, ms);
+    }
+
+    int64_t make_timestamp(int mon, int day, int h, int m, int s, int ms) {
+        if (mon < 1 || mon > 12 || day < 1) {
+            return -1;
+        }
+        int64_t days = days_before_month[mon - 1] + day - 1;
+        return (((days * 24 + h) * 60 + m) * 60 + s) * 1000 + ms;
+    }
+
+    void format_timestamp(int64_t ts, char* buf, size_t buf_size) {
+        if (ts < 0) {
+            snprintf(buf, buf_size, "--");
+            return;
+        }
+        int64_t days = ts / 86400000;
+        int64_t rem = ts % 86400000;
+        int mon = 0;
+        while (mon < 11 && days_before_month[mon + 1] <= days) {
+            mon++;
+        }
+        snprintf(buf, buf_size, "%02d-%02d %02d:%02d:%02d.%03d", mon + 1, (int)(days - days_before_month[mon]) + 1,
+            (int)(rem / 3600000), (int)(rem / 60000 % 60), (int)(rem / 1000 % 60), (int)(rem % 1000));
+    }
+
+    ImportJob::ImportJob(std::vector<std::string> paths, const LogFormat* format)
+        : paths(std::move(paths)), format(format != nullptr ? std::make_unique<const LogFormat>(*format) : nullptr) {}
+
+    void ImportJob::start() {
+        job.start([this] { run(); });
+    }
+
+    std::vector<std::shared_ptr<const LogBatch>> ImportJob::takeBatches() {
+        std::vector<std::shared_ptr<const LogBatch>> out;
+        std::lock_guard<std::mutex> lock(batches_mutex);
+        out.swap(batches);
+        return out;
+    }
+
+    void ImportJob::run() {
+        LoadFileSink sink;
+        sink.cancel = job.getCancelFlag();
+        sink.on_batch = [this](LogStats* staging) { publish(staging); };
+        load_files_new(paths, &stats, &sink, format.get());
+    }
+
+    // Loader thread: seal the complete records buffered in staging into an immutable batch.
+    // Templates are assigned here, once the records are complete, so the UI thread never pays for them.
+    void ImportJob::publish(LogStats* staging) {
+        auto batch = std::make_shared<LogBatch>();
+        batch->logs.swap(staging->logs);
+        for (LogDetailNew& d : batch->logs) {
+            d.template_id = templates.assign(d.content.data(), d.content.data() + d.first_line_len);
+        }
+        templates.takeChanged(&batch->changed_templates);
+        for (const auto& kv : staging->thread_name_map) {
+            if (published_names.emplace(kv.second.get(), true).second) {
+                batch->new_thread_names.push_back(kv);
+            }
+        }
+        for (const auto& kv : staging->file_name_map) {
+            if (published_names.emplace(kv.second.get(), true).second) {
+                batch->new_file_names.push_back(kv);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(batches_mutex);
+        batches.push_back(std::move(batch));
+    }
+
+    void LoadFileStats::setCurFileName(const std::string& name) {
+        std::lock_guard<std::mutex> lock(cur_file_name_mutex);
+        cur_file_name = name;
+    }
+
+    std::string LoadFileStats::getCurFileName() const {
+        std::lock_guard<std::mutex> lock(cur_file_name_mutex);
+        return cur_file_name;
+    }
+
+    void LoadFileStats::setCurFormatName(const std::string& name) {
+        std::lock_guard<std::mutex> lock(cur_file_name_mutex);
+        cur_format_name = name;
+    }
+
+    std::string LoadFileStats::getCurFormatName() const {
+        std::lock_guard<std::mutex> lock(cur_file_name_mutex);
+        return cur_format_name;
+    }
+
+    int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    double elapsed_seconds(const LoadFileStats& stats) {
+        int64_t start = stats.start_ns.load(std::memory_order_relaxed);
+        if (start == 0) {
+            return 0.0;
+        }
+        int64_t end = stats.end_ns.load(std::memory_order_relaxed);
+        if (end == 0) {
+            end = now_ns();
+        }
+        return (double)(end - start) / 1e9;
+    }
+
+    // Writes the counters as a single JSON object, for ingestion benchmarks and bug reports.
+    void dump_load_stats(const LoadFileStats& stats, std::ostream& os) {
+        double elapsed = elapsed_seconds(stats);
+        int64_t bytes = stats.bytes_read.load(std::memory_order_relaxed);
+        int64_t lines = stats.lines_parsed.load(std::memory_order_relaxed);
+        os << "{"
+            << "\"files\": " << stats.cur_file_count.load() << ", "
+            << "\"total_files\": " << stats.total_file_count.load() << ", "
+            << "\"bytes_read\": " << bytes << ", "
+            << "\"total_bytes\": " << stats.total_bytes.load() << ", "
+            << "\"lines_parsed\": " << lines << ", "
+            << "\"records_emitted\": " << stats.records_emitted.load() << ", "
+            << "\"elapsed_s\": " << elapsed << ", "
+            << "\"mb_per_s\": " << (elapsed > 0.0 ? bytes / (1024.0 * 1024.0) / elapsed : 0.0) << ", "
+            << "\"lines_per_s\": " << (elapsed > 0.0 ? lines / elapsed : 0.0) << ", "
+            << "\"read_s\": " << stats.read_ns.load() / 1e9 << ", "
+            << "\"parse_s\": " << stats.parse_ns.load() / 1e9 << ", "
+            << "\"emit_s\": " << stats.emit_ns.load() / 1e9
+            << "}" << std::endl;
+    }
+
     const std::string getFileName(const std::string& path) {
         size_t pos = path.find_last_of("/\\");
         if (pos == std::string::npos) {
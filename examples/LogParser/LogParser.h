@@ -6,32 +6,143 @@
 #include <fstream>
 #include <boost/regex.hpp>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include "LogTemplates.h"
+#include "LogFormat.h"
+#include "Parallel.h"
 
 namespace LogParser {
 
+    enum LogLevel : uint8_t {
+        LogLevel_Err,
+        LogLevel_Wrn,
+        LogLevel_Inf,
+        LogLevel_Dbg,
+        LogLevel_Other,
+        LogLevel_COUNT
+    };
+
     struct LogDetailNew {
         long id;
         const std::string* thread_name;
         const std::string* file_name;
         std::string prority, dt, content;
+        std::string raw_prefix;     // Header line up to the message, empty when it is the native "[prority thread,dt]:", which Export rebuilds
+        uint32_t raw_content_skip;  // Bytes at the start of content already in raw_prefix: the message of a JSON line, 0 otherwise
+        int64_t ts;                 // dt in milliseconds since Jan 1 00:00 (see parse_timestamp), -1 if malformed
+        uint32_t first_line_len;    // Offset of the first '\n' in content, or its size
+        uint32_t template_id;       // Index in LogStats::templates of the first line's template
+        LogLevel level;             // prority
     };
 
     struct LogStats {
         std::unordered_map<std::string, std::shared_ptr<const std::string>> thread_name_map;
         std::unordered_map<std::string, std::shared_ptr<const std::string>> file_name_map;
         std::vector<LogDetailNew> logs;
+        std::vector<std::string> templates;     // Message templates (see TemplateClusterer), filled by ImportJob
     };
 
+    // Progress of an import. Written by the loader thread and read by the UI thread every frame,
+    // so every counter is a relaxed atomic; the loader publishes them in batches (see LoadFileCounters).
     struct LoadFileStats {
-        bool loading = false;
-        int total_file_count = 0;
-        int cur_file_count = 0;
+        std::atomic<bool> loading{ false };
+        std::atomic<int> total_file_count{ 0 };
+        std::atomic<int> cur_file_count{ 0 };
+
+        std::atomic<int64_t> total_bytes{ 0 };
+        std::atomic<int64_t> bytes_read{ 0 };
+        std::atomic<int64_t> lines_parsed{ 0 };
+        std::atomic<int64_t> records_emitted{ 0 };
+
+        // Per-stage timings in nanoseconds: read = getline(), parse = format detection + header match, emit = build + append record.
+        // Estimated from a sample of the lines, their sum is the time spent in the loader loop.
+        std::atomic<int64_t> read_ns{ 0 };
+        std::atomic<int64_t> parse_ns{ 0 };
+        std::atomic<int64_t> emit_ns{ 0 };
+        std::atomic<int64_t> start_ns{ 0 };
+        std::atomic<int64_t> end_ns{ 0 };
+
+        void setCurFileName(const std::string& name);
+        std::string getCurFileName() const;
+        void setCurFormatName(const std::string& name);
+        std::string getCurFormatName() const;
+
+    private:
+        mutable std::mutex cur_file_name_mutex;
         std::string cur_file_name = "";
+        std::string cur_format_name = "";       // Format of the current file, given or detected
+    };
+
+    // Optional hooks for incremental loading. on_batch is called on the loader thread every time at least
+    // batch_size records are complete (and at the end of each file); it must move the records out of stats->logs.
+    struct LoadFileSink {
+        const std::atomic<bool>* cancel = nullptr;
+        size_t batch_size = 64 * 1024;
+        std::function<void(LogStats* stats)> on_batch;
+    };
+
+    // Records handed from the loader thread to the UI thread. Never modified once published.
+    // The batch also owns the names first referenced by its records, so the receiver can keep them alive.
+    struct LogBatch {
+        std::vector<LogDetailNew> logs;
+        std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> new_thread_names;
+        std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> new_file_names;
+        std::vector<std::pair<uint32_t, std::string>> changed_templates;   // Templates created or generalized by this batch
+    };
+
+    // One import running on its own thread. The UI thread polls takeBatches() each frame and appends the
+    // records to its own LogStats, so it never reads memory the loader is still writing.
+    // Without a format, the format of each file is detected from its first lines (see load_file_new).
+    class ImportJob {
+    public:
+        explicit ImportJob(std::vector<std::string> paths, const LogFormat* format = nullptr);
+
+        void start();
+        void cancel() { job.cancel(); }
+        bool isRunning() const { return job.isRunning(); }
+        bool isCancelled() const { return job.isCancelled(); }
+        std::vector<std::shared_ptr<const LogBatch>> takeBatches();
+
+        LoadFileStats stats;
+
+    private:
+        void run();
+        void publish(LogStats* staging);
+
+        std::vector<std::string> paths;
+        std::unique_ptr<const LogFormat> format;
+        std::mutex batches_mutex;
+        std::vector<std::shared_ptr<const LogBatch>> batches;
+        std::unordered_map<const std::string*, bool> published_names;
+        TemplateClusterer templates;
+        BackgroundJob job;
     };
 
     const LogStats load_logs_new();
-    const LogStats load_files_new(const std::vector<std::string>& const paths, LogParser::LoadFileStats* stats);
-    const void load_file_new(long* id, const std::string* path, LogStats* stats);
+    const LogStats load_files_new(const std::vector<std::string>& paths, LogParser::LoadFileStats* stats, const LoadFileSink* sink = nullptr, const LogFormat* format = nullptr);
+    // Reads the records of a file in the given format. Without one (or if it doesn't compile), the builtin format
+    // matching most of the first DetectSampleLines lines is used.
+    const void load_file_new(long* id, const std::string* path, LogStats* stats, LoadFileStats* load_stats = nullptr, const LoadFileSink* sink = nullptr, const LogFormat* format = nullptr);
+    void append_batch(LogStats* stats, const LogBatch& batch);
+
+    const size_t DetectSampleLines = 64;
+
+    // "ERR", "WRN", "INF", "DBG" and the usual longer names ("error", "Warning", "FATAL", "trace"...), in any case.
+    LogLevel parse_level(std::string_view s);
+    const char* get_level_name(LogLevel level);
+    int64_t parse_timestamp(const std::string& dt);
+    int64_t parse_timestamp(const char* dt, size_t len);
+    // Milliseconds since Jan 1 00:00 (see parse_timestamp), -1 if mon or day is out of range.
+    int64_t make_timestamp(int mon, int day, int h, int m, int s, int ms);
+    void format_timestamp(int64_t ts, char* buf, size_t buf_size);
+
+    int64_t now_ns();
+    double elapsed_seconds(const LoadFileStats& stats);
+    void dump_load_stats(const LoadFileStats& stats, std::ostream& os);
 
     const std::string getFileName(const std::string& path);
 }
@@ -0,0 +1,517 @@
+// Headless benchmark for the log viewer ingestion and filtering paths.
+// Generates a deterministic synthetic log set in the '[LVL thread,MM-DD hh:mm:ss.fff]:content' format,
+// then times import (load_files_new through an ImportJob), filter, find, group by thread and export the same way the viewer runs them,
+// diffs the dataset against itself, measures every record with the default Dear ImGui font, times ID hashing
+// of labels of typical lengths and of whole records, and times ImGuiStorage insertions and lookups at 1k, 100k and 1M keys.
+// Build with 'make STORAGE=open' to time the open-addressing ImGuiStorage (IMGUI_STORAGE_OPEN_ADDRESSING) instead of the sorted one.
+//
+// Usage: log_parser_bench [options]
+//   --lines N                 Header lines to generate (default 1000000)
+//   --files N                 Split them over N files (default 4)
+//   --line-length N           Mean length of a header line in bytes (default 160)
+//   --continuation-ratio F    Probability for a record to be followed by continuation lines (default 0.05)
+//   --threads N               Number of distinct thread names (default 32)
+//   --seed N                  Generator seed (default 1)
+//   --dir PATH                Where to write the generated files (default: system temp directory)
+//   --filter EXPR             Filter expression (default 'C2="ERR|WRN"')
+//   --find EXPR               Find expression applied on top of the filter (default 'timeout')
+//   --iterations N            Repeat filter, find, group, export, text measurement, hashing and ImGuiStorage N times, best time is reported (default 3)
+//   --export-format F         raw, csv or ndjson (default raw); the filtered rows are exported next to the generated files
+//   --json                    Print the results as a single JSON object
+//   --min-lines-per-s N       Exit with code 1 if import runs slower than this (for CI)
+//   --keep                    Keep the generated files
+
+#include "LogParser.h"
+#include "LogFilter.h"
+#include "GroupBy.h"
+#include "Export.h"
+#include "LogDiff.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+struct BenchOptions {
+    long lines = 1000000;
+    int files = 4;
+    int line_length = 160;
+    double continuation_ratio = 0.05;
+    int threads = 32;
+    uint64_t seed = 1;
+    std::string dir;
+    std::string filter = "C2=\"ERR|WRN\"";
+    std::string find = "timeout";
+    int iterations = 3;
+    LogParser::ExportFormat export_format = LogParser::ExportFormat_Raw;
+    bool json = false;
+    double min_lines_per_s = 0.0;
+    bool keep = false;
+};
+
+struct StageResult {
+    const char* name;
+    double seconds;
+    int64_t bytes;
+    int64_t lines;
+    int64_t matches;
+};
+
+// xorshift64*: fast, and identical output on every platform for a given seed
+struct BenchRandom {
+    uint64_t state;
+    explicit BenchRandom(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+    int range(int n) { return (int)(next() % (uint64_t)n); }
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+static const char* words[] = {
+    "request", "response", "timeout", "connection", "session", "user", "cache", "miss", "hit", "retry",
+    "queue", "worker", "flush", "commit", "rollback", "socket", "closed", "opened", "payload", "bytes",
+    "latency", "ms", "handler", "dispatch", "order", "account", "token", "expired", "invalid", "ok",
+};
+
+static volatile ImGuiID bench_hash_sink;    // Keeps the hashes from being optimized out
+
+// Label of length len (with a "##" suffix, as most labels have one), zero-terminated
+static void make_label(int len, int i, std::string* out) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "##%d", i);
+    out->clear();
+    for (int k = 0; out->size() < (size_t)len; k++) {
+        *out += words[(i + k) % (int)(sizeof(words) / sizeof(words[0]))];
+        *out += k ? " " : suffix;
+    }
+    out->resize((size_t)len);
+}
+
+static int64_t generate_logs(const BenchOptions& opt, std::vector<std::string>* paths) {
+    BenchRandom rng(opt.seed);
+    int64_t total_bytes = 0;
+    int64_t ts = ((31 + 29 + 7) * 24LL) * 3600 * 1000; // 03-08 00:00:00.000
+    std::string line;
+    for (int f = 0; f < opt.files; f++) {
+        char name[64];
+        snprintf(name, sizeof(name), "bench-%04d.log", f);
+        std::string path = (fs::path(opt.dir) / name).string();
+        std::ofstream out(path, std::ios::binary);
+        const long begin = opt.lines * f / opt.files;
+        const long end = opt.lines * (f + 1) / opt.files;
+        for (long i = begin; i < end; i++) {
+            ts += rng.range(20);
+            const int r = rng.range(100);
+            const char* level = r < 5 ? "ERR" : r < 15 ? "WRN" : r < 30 ? "DBG" : "INF";
+            const int64_t day_ms = ts % 86400000;
+            char header[96];
+            snprintf(header, sizeof(header), "[%s worker-%d,03-%02d %02d:%02d:%02d.%03d]:", level, rng.range(opt.threads),
+                (int)(8 + ts / 86400000 - 67), (int)(day_ms / 3600000), (int)(day_ms / 60000 % 60), (int)(day_ms / 1000 % 60), (int)(day_ms % 1000));
+            line = header;
+
+            // Mean length line_length, +-25%
+            const size_t target = (size_t)(opt.line_length * (0.75 + 0.5 * rng.unit()));
+            while (line.size() < target) {
+                if (rng.range(4) == 0) {
+                    char num[32];
+                    snprintf(num, sizeof(num), " id=%llx", (unsigned long long)(rng.next() & 0xFFFFFFFFull));
+                    line += num;
+                }
+                else {
+                    line += ' ';
+                    line += words[rng.range((int)(sizeof(words) / sizeof(words[0])))];
+                }
+            }
+            line += '\n';
+
+            if (rng.unit() < opt.continuation_ratio) {
+                const int count = 1 + rng.range(8);
+                for (int k = 0; k < count; k++) {
+                    char cont[96];
+                    snprintf(cont, sizeof(cont), "    at com.example.Service%d.handle(Service.java:%d)\n", rng.range(50), rng.range(2000));
+                    line += cont;
+                }
+            }
+            out.write(line.data(), (std::streamsize)line.size());
+            total_bytes += (int64_t)line.size();
+        }
+        paths->push_back(path);
+    }
+    return total_bytes;
+}
+
+static int64_t get_peak_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return (int64_t)pmc.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return (int64_t)usage.ru_maxrss;
+#else
+    return (int64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+static bool parse_options(int argc, char** argv, BenchOptions* opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--json") == 0) { opt->json = true; continue; }
+        if (strcmp(arg, "--keep") == 0) { opt->keep = true; continue; }
+        if (value == nullptr) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+        if (strcmp(arg, "--lines") == 0) opt->lines = atol(value);
+        else if (strcmp(arg, "--files") == 0) opt->files = atoi(value);
+        else if (strcmp(arg, "--line-length") == 0) opt->line_length = atoi(value);
+        else if (strcmp(arg, "--continuation-ratio") == 0) opt->continuation_ratio = atof(value);
+        else if (strcmp(arg, "--threads") == 0) opt->threads = atoi(value);
+        else if (strcmp(arg, "--seed") == 0) opt->seed = strtoull(value, nullptr, 10);
+        else if (strcmp(arg, "--dir") == 0) opt->dir = value;
+        else if (strcmp(arg, "--filter") == 0) opt->filter = value;
+        else if (strcmp(arg, "--find") == 0) opt->find = value;
+        else if (strcmp(arg, "--iterations") == 0) opt->iterations = atoi(value);
+        else if (strcmp(arg, "--export-format") == 0) {
+            if (strcmp(value, "raw") == 0) opt->export_format = LogParser::ExportFormat_Raw;
+            else if (strcmp(value, "csv") == 0) opt->export_format = LogParser::ExportFormat_Csv;
+            else if (strcmp(value, "ndjson") == 0) opt->export_format = LogParser::ExportFormat_Ndjson;
+            else {
+                fprintf(stderr, "Unknown export format %s\n", value);
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--min-lines-per-s") == 0) opt->min_lines_per_s = atof(value);
+        else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    opt->files = std::max(opt->files, 1);
+    opt->threads = std::max(opt->threads, 1);
+    opt->iterations = std::max(opt->iterations, 1);
+    if (opt->dir.empty()) {
+        opt->dir = (fs::temp_directory_path() / "log_parser_bench").string();
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!parse_options(argc, argv, &opt)) {
+        return 2;
+    }
+    fs::create_directories(opt.dir);
+
+    std::vector<std::string> paths;
+    int64_t t0 = LogParser::now_ns();
+    const int64_t generated_bytes = generate_logs(opt, &paths);
+    const double generate_s = (LogParser::now_ns() - t0) / 1e9;
+
+    // Import, through the same job + batch handoff as the viewer
+    LogParser::LogStats db;
+    std::ostringstream load_stats_json;
+    t0 = LogParser::now_ns();
+    int64_t append_ns = 0;
+    {
+        LogParser::ImportJob job(paths);
+        job.start();
+        while (true) {
+            const bool running = job.isRunning();
+            for (const auto& batch : job.takeBatches()) {
+                const int64_t a0 = LogParser::now_ns();
+                LogParser::append_batch(&db, *batch);
+                append_ns += LogParser::now_ns() - a0;
+            }
+            if (!running) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        LogParser::dump_load_stats(job.stats, load_stats_json);
+    }
+    const double import_s = (LogParser::now_ns() - t0) / 1e9;
+    int64_t total_lines = 0;
+    for (const LogParser::LogDetailNew& d : db.logs) {
+        total_lines += 1 + (int64_t)std::count(d.content.begin(), d.content.end(), '\n');
+    }
+
+    // Filter and find, as typed in the Filter box and the Find tab
+    LogParser::Filter filter;
+    LogParser::Filter find;
+    snprintf(filter.str, sizeof(filter.str), "%s", opt.filter.c_str());
+    snprintf(find.str, sizeof(find.str), "%s", opt.find.c_str());
+    double filter_s = 1e30, find_s = 1e30, group_s = 1e30, export_s = 1e30;
+    int64_t filter_matches = 0, find_matches = 0, groups = 0, export_bytes = 0;
+    const std::string export_path = (fs::path(opt.dir) / "bench-export.out").string();
+    boost::smatch matches;
+    for (int it = 0; it < opt.iterations; it++) {
+        t0 = LogParser::now_ns();
+        LogParser::parseFilter(&filter);
+        std::vector<uint32_t> rows;
+        for (size_t i = 0; i < db.logs.size(); i++) {
+            if (LogParser::isLineMatchFilter(db.logs[i], filter, matches)) {
+                rows.push_back((uint32_t)i);
+            }
+        }
+        filter_s = std::min(filter_s, (LogParser::now_ns() - t0) / 1e9);
+        filter_matches = (int64_t)rows.size();
+
+        t0 = LogParser::now_ns();
+        LogParser::parseFilter(&find);
+        int64_t found = 0;
+        for (uint32_t row : rows) {
+            if (LogParser::isLineMatchFilter(db.logs[row], find, matches)) {
+                found++;
+            }
+        }
+        find_s = std::min(find_s, (LogParser::now_ns() - t0) / 1e9);
+        find_matches = found;
+
+        // Group By tab over the filtered view
+        t0 = LogParser::now_ns();
+        LogParser::GroupBy group_by;
+        group_by.update(db, rows);
+        group_s = std::min(group_s, (LogParser::now_ns() - t0) / 1e9);
+        groups = (int64_t)std::count_if(group_by.getGroups().begin(), group_by.getGroups().end(), [](const LogParser::GroupBy::Group& g) { return g.count > 0; });
+
+        // Export of the filtered view
+        t0 = LogParser::now_ns();
+        LogParser::ExportStats export_stats;
+        std::string error;
+        if (!LogParser::export_rows(db, rows, export_path, opt.export_format, &export_stats, nullptr, &error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        export_s = std::min(export_s, (LogParser::now_ns() - t0) / 1e9);
+        export_bytes = export_stats.bytes_written.load();
+    }
+
+    const int64_t records = (int64_t)db.logs.size();
+
+    // Diff of the dataset against itself, once: every row is aggregated twice
+    t0 = LogParser::now_ns();
+    LogParser::LogDiff diff;
+    LogParser::diff_logs(db, db, &diff);
+    const double diff_s = (LogParser::now_ns() - t0) / 1e9;
+
+    // Text measurement with the default font, as the table auto-fits its columns (text_size) and the detail pane
+    // wraps the selected record (text_wrap, at 600 pixels)
+    ImGui::CreateContext();
+    ImGui::GetIO().Fonts->Build();
+    const ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    const float wrap_width = 600.0f;
+    double text_size_s = 1e30, text_wrap_s = 1e30;
+    int64_t content_bytes = 0, widest = 0, wrapped_lines = 0;
+    for (const LogParser::LogDetailNew& d : db.logs) {
+        content_bytes += (int64_t)d.content.size();
+    }
+    for (int it = 0; it < opt.iterations; it++) {
+        t0 = LogParser::now_ns();
+        float max_width = 0.0f;
+        for (const LogParser::LogDetailNew& d : db.logs) {
+            const ImVec2 size = font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, d.content.data(), d.content.data() + d.content.size());
+            max_width = std::max(max_width, size.x);
+        }
+        text_size_s = std::min(text_size_s, (LogParser::now_ns() - t0) / 1e9);
+        widest = (int64_t)max_width;
+
+        t0 = LogParser::now_ns();
+        float height = 0.0f;
+        for (const LogParser::LogDetailNew& d : db.logs) {
+            height += font->CalcTextSizeA(font->FontSize, FLT_MAX, wrap_width, d.content.data(), d.content.data() + d.content.size()).y;
+        }
+        text_wrap_s = std::min(text_wrap_s, (LogParser::now_ns() - t0) / 1e9);
+        wrapped_lines = (int64_t)(height / font->FontSize + 0.5f);
+    }
+    ImGui::DestroyContext();
+
+    // ID hashing: zero-terminated labels through ImHashStr() as GetID() does, whole records through ImHashData()
+    const int label_lengths[] = { 8, 24, 64 };
+    const int label_count = 64 * 1024;
+    const int label_rounds = 16;
+    double hash_str_s[3] = { 1e30, 1e30, 1e30 };
+    double hash_data_s = 1e30;
+    ImGuiID hash_sum = 0;
+    std::string label;
+    for (int l = 0; l < 3; l++) {
+        const int len = label_lengths[l];
+        std::vector<char> labels((size_t)label_count * (len + 1), 0);
+        for (int i = 0; i < label_count; i++) {
+            make_label(len, i, &label);
+            memcpy(&labels[(size_t)i * (len + 1)], label.data(), (size_t)len);
+        }
+        for (int it = 0; it < opt.iterations; it++) {
+            t0 = LogParser::now_ns();
+            for (int r = 0; r < label_rounds; r++) {
+                for (int i = 0; i < label_count; i++) {
+                    hash_sum += ImHashStr(&labels[(size_t)i * (len + 1)], 0, (ImGuiID)r);
+                }
+            }
+            hash_str_s[l] = std::min(hash_str_s[l], (LogParser::now_ns() - t0) / 1e9);
+        }
+    }
+    for (int it = 0; it < opt.iterations; it++) {
+        t0 = LogParser::now_ns();
+        for (const LogParser::LogDetailNew& d : db.logs) {
+            hash_sum += ImHashData(d.content.data(), d.content.size(), 0);
+        }
+        hash_data_s = std::min(hash_data_s, (LogParser::now_ns() - t0) / 1e9);
+    }
+    const int64_t label_hashes = (int64_t)label_count * label_rounds;
+
+    // ImGuiStorage: SetInt() of random keys (IDs are hashes) into an empty storage, then GetInt() of random present keys,
+    // at 1k, 100k and 1M keys. The sorted storage is quadratic on insertion, its 1M insertion is skipped.
+    const int storage_sizes[] = { 1000, 100000, 1000000 };
+    const int64_t storage_ops = 4000000;
+    double storage_set_s[3] = { 1e30, 1e30, 1e30 };
+    double storage_get_s[3] = { 1e30, 1e30, 1e30 };
+    int64_t storage_sets[3] = {}, storage_gets[3] = {};
+    for (int z = 0; z < 3; z++) {
+        const int n = storage_sizes[z];
+        BenchRandom key_rng(opt.seed + z);
+        std::vector<ImGuiID> keys((size_t)n);
+        for (ImGuiID& key : keys) {
+            key = (ImGuiID)key_rng.next();
+        }
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+        const bool skip_set = false;
+#else
+        const bool skip_set = n > 100000;
+#endif
+        const int set_rounds = n < 100000 ? 1000000 / n : 1;    // The sorted storage takes seconds for one 100k round
+        for (int it = 0; it < opt.iterations && !skip_set; it++) {
+            t0 = LogParser::now_ns();
+            for (int r = 0; r < set_rounds; r++) {
+                ImGuiStorage storage;
+                for (int i = 0; i < n; i++) {
+                    storage.SetInt(keys[i], i);
+                }
+                hash_sum += (ImGuiID)storage.Data.Size;
+            }
+            storage_set_s[z] = std::min(storage_set_s[z], (LogParser::now_ns() - t0) / 1e9);
+            storage_sets[z] = (int64_t)set_rounds * n;
+        }
+        if (skip_set) {
+            storage_set_s[z] = 0.0;
+        }
+
+        // Built in one go, as ImGuiStorage::BuildSortByKey() allows
+        ImGuiStorage storage;
+        storage.Data.reserve(n);
+        for (int i = 0; i < n; i++) {
+            storage.Data.push_back(ImGuiStorage::ImGuiStoragePair(keys[i], i));
+        }
+        storage.BuildSortByKey();
+        std::vector<ImGuiID> queries((size_t)storage_ops);
+        for (ImGuiID& query : queries) {
+            query = keys[key_rng.range(n)];
+        }
+        for (int it = 0; it < opt.iterations; it++) {
+            t0 = LogParser::now_ns();
+            for (ImGuiID query : queries) {
+                hash_sum += (ImGuiID)storage.GetInt(query, -1);
+            }
+            storage_get_s[z] = std::min(storage_get_s[z], (LogParser::now_ns() - t0) / 1e9);
+        }
+        storage_gets[z] = storage_ops;
+    }
+    bench_hash_sink = hash_sum;
+
+    const StageResult stages[] = {
+        { "import", import_s, generated_bytes, total_lines, records },
+        { "filter", filter_s, 0, records, filter_matches },    // lines = records tested
+        { "find", find_s, 0, filter_matches, find_matches },
+        { "group", group_s, 0, filter_matches, groups },    // matches = groups
+        { "export", export_s, export_bytes, filter_matches, filter_matches },
+        { "diff", diff_s, 0, 2 * records, (int64_t)diff.rows[LogParser::DiffKey_Template].size() },    // matches = patterns
+        { "text_size", text_size_s, content_bytes, total_lines, widest },    // matches = widest record in pixels
+        { "text_wrap", text_wrap_s, content_bytes, total_lines, wrapped_lines },    // matches = wrapped lines
+        { "hash_str8", hash_str_s[0], label_hashes * 8, label_hashes, label_hashes },     // lines = labels hashed
+        { "hash_str24", hash_str_s[1], label_hashes * 24, label_hashes, label_hashes },
+        { "hash_str64", hash_str_s[2], label_hashes * 64, label_hashes, label_hashes },
+        { "hash_data", hash_data_s, content_bytes, records, records },
+        { "set_1k", storage_set_s[0], 0, storage_sets[0], storage_sets[0] },     // lines = ImGuiStorage::SetInt() calls
+        { "get_1k", storage_get_s[0], 0, storage_gets[0], storage_gets[0] },     // lines = ImGuiStorage::GetInt() calls
+        { "set_100k", storage_set_s[1], 0, storage_sets[1], storage_sets[1] },
+        { "get_100k", storage_get_s[1], 0, storage_gets[1], storage_gets[1] },
+        { "set_1m", storage_set_s[2], 0, storage_sets[2], storage_sets[2] },
+        { "get_1m", storage_get_s[2], 0, storage_gets[2], storage_gets[2] },
+    };
+    const int64_t peak_rss = get_peak_rss_bytes();
+    std::string load_stats_str = load_stats_json.str();
+    while (!load_stats_str.empty() && load_stats_str.back() == '\n') {
+        load_stats_str.pop_back();
+    }
+    const double import_lines_per_s = import_s > 0.0 ? total_lines / import_s : 0.0;
+
+    if (opt.json) {
+        printf("{\"lines\": %lld, \"files\": %d, \"line_length\": %d, \"continuation_ratio\": %g, \"threads\": %d, \"seed\": %llu, ",
+            (long long)opt.lines, opt.files, opt.line_length, opt.continuation_ratio, opt.threads, (unsigned long long)opt.seed);
+        printf("\"generated_bytes\": %lld, \"generate_s\": %.6f, \"append_s\": %.6f, \"peak_rss_bytes\": %lld, \"templates\": %zu, ",
+            (long long)generated_bytes, generate_s, append_ns / 1e9, (long long)peak_rss, db.templates.size());
+        printf("\"load_stats\": %s, ", load_stats_str.c_str());
+        printf("\"stages\": {");
+        for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+            const StageResult& s = stages[i];
+            printf("%s\"%s\": {\"s\": %.6f, \"lines_per_s\": %.1f, ", i ? ", " : "", s.name, s.seconds, s.seconds > 0.0 ? s.lines / s.seconds : 0.0);
+            if (s.bytes > 0) {
+                printf("\"mb_per_s\": %.2f, ", s.seconds > 0.0 ? s.bytes / (1024.0 * 1024.0) / s.seconds : 0.0);
+            }
+            printf("\"matches\": %lld}", (long long)s.matches);
+        }
+        printf("}}\n");
+    }
+    else {
+        printf("Generated %lld records, %.1f MB in %d files (%.2fs)\n", (long long)opt.lines, generated_bytes / (1024.0 * 1024.0), opt.files, generate_s);
+        printf("%-10s %10s %14s %10s %12s\n", "stage", "time (s)", "lines/s", "MB/s", "matches");
+        for (const StageResult& s : stages) {
+            char mb_per_s[32] = "-";
+            if (s.bytes > 0 && s.seconds > 0.0) {
+                snprintf(mb_per_s, sizeof(mb_per_s), "%.1f", s.bytes / (1024.0 * 1024.0) / s.seconds);
+            }
+            printf("%-10s %10.3f %14.0f %10s %12lld\n", s.name, s.seconds, s.seconds > 0.0 ? s.lines / s.seconds : 0.0, mb_per_s, (long long)s.matches);
+        }
+        printf("Import stages: %s\n", load_stats_str.c_str());
+        printf("UI-side batch append: %.3fs\n", append_ns / 1e9);
+        printf("Message templates: %zu\n", db.templates.size());
+        printf("Peak RSS: %.1f MB\n", peak_rss / (1024.0 * 1024.0));
+    }
+
+    if (!opt.keep) {
+        paths.push_back(export_path);
+        for (const std::string& path : paths) {
+            std::error_code ec;
+            fs::remove(path, ec);
+        }
+    }
+
+    if (opt.min_lines_per_s > 0.0 && import_lines_per_s < opt.min_lines_per_s) {
+        fprintf(stderr, "Import too slow: %.0f lines/s < %.0f lines/s\n", import_lines_per_s, opt.min_lines_per_s);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "LogTemplates.h"
+#include <string_view>
+
+namespace LogParser {
+
+    enum CharClass : uint8_t {
+        CharClass_Digit = 1 << 0,
+        CharClass_Hex = 1 << 1,
+        CharClass_Word = 1 << 2,   // Letters, digits and '_'
+    };
+
+    struct CharClassTable {
+        uint8_t flags[256] = {};
+        CharClassTable() {
+            for (int c = 0; c < 256; c++) {
+                const bool digit = c >= '0' && c <= '9';
+                const bool hex_letter = (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+                const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+                flags[c] = (digit ? CharClass_Digit : 0) | (digit || hex_letter ? CharClass_Hex : 0) | (digit || letter ? CharClass_Word : 0);
+            }
+        }
+    };
+    static const CharClassTable char_class;
+
+    static bool is_digit(char c) { return (char_class.flags[(uint8_t)c] & CharClass_Digit) != 0; }
+    static bool is_word(char c) { return (char_class.flags[(uint8_t)c] & CharClass_Word) != 0; }
+    static bool is_hex(char c) { return (char_class.flags[(uint8_t)c] & CharClass_Hex) != 0; }
+
+    // 8-4-4-4-12 hex digits, not followed by a word character
+    static bool is_uuid(const char* p, const char* end) {
+        static const int group_len[5] = { 8, 4, 4, 4, 12 };
+        if (end - p < 36) {
+            return false;
+        }
+        for (int g = 0; g < 5; g++) {
+            for (int i = 0; i < group_len[g]; i++, p++) {
+                if (!is_hex(*p)) {
+                    return false;
+                }
+            }
+            if (g < 4 && *p++ != '-') {
+                return false;
+            }
+        }
+        return p == end || !is_word(*p);
+    }
+
+    void mask_message(const char* begin, const char* end, std::string* out) {
+        if ((size_t)(end - begin) > TemplateClusterer::MaxMaskedLen) {
+            end = begin + TemplateClusterer::MaxMaskedLen;
+        }
+        out->clear();
+        const char* copied = begin;    // Input before this is already in out
+        const char* p = begin;
+        while (p < end) {
+            if (!is_word(*p)) {
+                p++;
+                continue;
+            }
+
+            // Start of a word. Only a hex digit can start something to mask, is_uuid() fails on the first other character.
+            const char* q = p;
+            const char* placeholder = nullptr;
+            if (is_uuid(p, end)) {
+                q = p + 36;
+                placeholder = "<UUID>";
+            }
+            else if (is_hex(*p)) {
+                const bool prefixed = p[0] == '0' && end - p > 2 && (p[1] == 'x' || p[1] == 'X') && is_hex(p[2]);
+                bool digits = false, letters = false;
+                for (q = prefixed ? p + 2 : p; q < end && is_hex(*q); q++) {
+                    digits |= is_digit(*q);
+                    letters |= !is_digit(*q);
+                }
+                if ((q == end || !is_word(*q)) && (prefixed || (digits && letters && q - p >= 6))) {
+                    placeholder = "<HEX>";
+                }
+                else if (is_digit(*p)) {
+                    for (q = p; q < end && is_digit(*q); q++);
+                    if (q + 1 < end && *q == '.' && is_digit(q[1])) {
+                        for (q++; q < end && is_digit(*q); q++);
+                    }
+                    placeholder = "<NUM>";
+                }
+            }
+            if (placeholder != nullptr) {
+                out->append(copied, p);
+                out->append(placeholder);
+                copied = q;
+            }
+
+            // The rest of the word is kept ("<NUM>ms"), digits in it are part of it
+            for (p = q; p < end && is_word(*p); p++);
+        }
+        out->append(copied, end);
+    }
+
+    uint32_t TemplateClusterer::assign(const char* begin, const char* end) {
+        mask_message(begin, end, &masked);
+        uint64_t masked_hash = std::hash<std::string_view>()(masked);
+        masked_hash = masked_hash ? masked_hash : 1;
+        if (exact.empty()) {
+            exact.resize(ExactCacheSize);
+        }
+        ExactEntry& cached = exact[masked_hash & (ExactCacheSize - 1)];
+        if (cached.hash == masked_hash) {
+            return cached.id;
+        }
+
+        // Split on spaces and hash every token (FNV-1a) in the same pass. Hashes are never 0, which stands for <*>.
+        token_ranges.clear();
+        token_hashes.clear();
+        const char* s = masked.data();
+        const size_t size = masked.size();
+        for (size_t i = 0; i < size; ) {
+            if (s[i] == ' ') {
+                i++;
+                continue;
+            }
+            size_t j = i;
+            uint64_t h = 14695981039346656037ull;
+            for (; j < size && s[j] != ' '; j++) {
+                h = (h ^ (uint8_t)s[j]) * 1099511628211ull;
+            }
+            token_ranges.emplace_back(i, j);
+            token_hashes.push_back(h ? h : 1);
+            i = j;
+        }
+        const uint64_t bucket_key = (token_hashes.empty() ? 0 : token_hashes[0]) * 31 + token_hashes.size();
+
+        // Most similar template of the bucket; <*> matches anything
+        std::vector<uint32_t>& bucket = buckets[bucket_key];
+        int best = -1;
+        size_t best_matches = 0;
+        for (size_t b = 0; b < bucket.size(); b++) {
+            const std::vector<uint64_t>& hashes = clusters[bucket[b]].hashes;
+            if (hashes.size() != token_hashes.size()) {
+                continue;   // Bucket key collision
+            }
+            size_t matches = 0;
+            for (size_t i = 0; i < hashes.size(); i++) {
+                matches += (hashes[i] == 0 || hashes[i] == token_hashes[i]) ? 1 : 0;
+            }
+            if (best < 0 || matches > best_matches) {
+                best = (int)b;
+                best_matches = matches;
+                if (matches == hashes.size()) {
+                    break;
+                }
+            }
+        }
+
+        uint32_t id;
+        if (best >= 0 && (best_matches * 2 >= token_hashes.size() || bucket.size() >= MaxBucketTemplates)) {
+            id = bucket[best];
+            merge(id);
+            // Templates that keep matching move to the front, they are tried first
+            std::swap(bucket[best], bucket[best / 2]);
+        }
+        else {
+            id = addCluster(&bucket);
+        }
+
+        cached.hash = masked_hash;
+        cached.id = id;
+        return id;
+    }
+
+    uint32_t TemplateClusterer::addCluster(std::vector<uint32_t>* bucket) {
+        const uint32_t id = (uint32_t)clusters.size();
+        clusters.emplace_back();
+        Cluster& cluster = clusters.back();
+        cluster.hashes = token_hashes;
+        for (const auto& range : token_ranges) {
+            cluster.tokens.emplace_back(masked, range.first, range.second - range.first);
+        }
+        cluster.text = masked;
+        cluster.changed = true;
+        changed.push_back(id);
+        bucket->push_back(id);
+        return id;
+    }
+
+    // Generalizes the template to also cover the tokens of the current message.
+    void TemplateClusterer::merge(uint32_t id) {
+        Cluster& cluster = clusters[id];
+        bool generalized = false;
+        for (size_t i = 0; i < cluster.hashes.size(); i++) {
+            if (cluster.hashes[i] != 0 && cluster.hashes[i] != token_hashes[i]) {
+                cluster.hashes[i] = 0;
+                cluster.tokens[i] = "<*>";
+                generalized = true;
+            }
+        }
+        if (!generalized) {
+            return;
+        }
+        cluster.text.clear();
+        for (size_t i = 0; i < cluster.tokens.size(); i++) {
+            if (i > 0) {
+                cluster.text += ' ';
+            }
+            cluster.text += cluster.tokens[i];
+        }
+        if (!cluster.changed) {
+            cluster.changed = true;
+            changed.push_back(id);
+        }
+    }
+
+    void TemplateClusterer::takeChanged(std::vector<std::pair<uint32_t, std::string>>* out) {
+        for (uint32_t id : changed) {
+            clusters[id].changed = false;
+            out->emplace_back(id, clusters[id].text);
+        }
+        changed.clear();
+    }
+}
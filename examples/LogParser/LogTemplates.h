@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace LogParser {
+
+    // Copies a message with its variable tokens replaced by placeholders: UUIDs by <UUID>, 0x numbers and hex ids
+    // (6+ hex digits, letters and digits mixed) by <HEX>, numbers not glued to a word ("worker-12" but not "utf8") by <NUM>.
+    // At most MaxMaskedLen bytes of input are used.
+    void mask_message(const char* begin, const char* end, std::string* out);
+
+    // Groups messages by template, one message at a time, with a Drain-style clustering: masked messages are
+    // split into space separated tokens and bucketed by token count and first token. A message joins the most
+    // similar template of its bucket when at least half of the tokens match, and the tokens that differ become
+    // <*>; otherwise it starts a new template. Masked messages seen before skip the clustering entirely.
+    // Template ids never change, but the text of a template may get more general as messages arrive.
+    class TemplateClusterer {
+    public:
+        static const size_t MaxMaskedLen = 1024;
+        static const size_t MaxBucketTemplates = 64;    // A full bucket merges into its closest template instead of growing
+        static const size_t ExactCacheSize = 64 * 1024; // Power of 2
+
+        uint32_t assign(const char* begin, const char* end);
+
+        size_t size() const { return clusters.size(); }
+        const std::string& getTemplate(uint32_t id) const { return clusters[id].text; }
+
+        // Appends (id, text) of every template created or generalized since the last call.
+        void takeChanged(std::vector<std::pair<uint32_t, std::string>>* out);
+
+    private:
+        struct Cluster {
+            std::vector<uint64_t> hashes;       // Per token, 0 for <*>
+            std::vector<std::string> tokens;
+            std::string text;
+            bool changed = false;
+        };
+
+        struct ExactEntry {
+            uint64_t hash = 0;      // Hash of a masked message, 0 if unused
+            uint32_t id = 0;
+        };
+
+        uint32_t addCluster(std::vector<uint32_t>* bucket);
+        void merge(uint32_t id);
+
+        std::vector<Cluster> clusters;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;   // Hash of token count + first token -> template ids, most used first
+        std::vector<ExactEntry> exact;                                  // Direct-mapped cache of masked messages seen before
+        std::vector<uint32_t> changed;
+
+        // Scratch, kept to avoid allocating per message
+        std::string masked;
+        std::vector<std::pair<size_t, size_t>> token_ranges;
+        std::vector<uint64_t> token_hashes;
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LogParser {
+
+    // Threads worth using for count rows: one per core, but at least 64K rows each.
+    inline int get_worker_count(size_t count) {
+        const size_t min_rows_per_worker = 64 * 1024;
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = std::min(workers, count / min_rows_per_worker + 1);
+        return (int)workers;
+    }
+
+    // Runs fn(worker, begin, end) over count items split in contiguous chunks, one thread per chunk.
+    template<typename FN>
+    void parallel_for_chunks(int workers, size_t count, FN fn) {
+        std::vector<std::thread> threads;
+        for (int w = 1; w < workers; w++) {
+            threads.emplace_back(fn, w, count * w / workers, count * (w + 1) / workers);
+        }
+        fn(0, 0, count / workers);
+        for (std::thread& t : threads) {
+            t.join();
+        }
+    }
+
+    // Same split as parallel_for_chunks, on threads started once and reused for every run(). For algorithms
+    // making several passes over the same data, e.g. one per radix digit. run() must not be called concurrently.
+    class WorkerPool {
+    public:
+        explicit WorkerPool(int workers) : worker_count(std::max(workers, 1)) {
+            for (int w = 1; w < worker_count; w++) {
+                threads.emplace_back(&WorkerPool::workerMain, this, w);
+            }
+        }
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& t : threads) {
+                t.join();
+            }
+        }
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        int size() const { return worker_count; }
+
+        // Runs fn(worker, begin, end) over count items and returns once every chunk is done.
+        void run(size_t count, const std::function<void(int, size_t, size_t)>& fn) {
+            if (worker_count == 1) {
+                fn(0, 0, count);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = &fn;
+                job_count = count;
+                pending = worker_count - 1;
+                generation++;
+            }
+            wake.notify_all();
+            fn(0, 0, count / worker_count);
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return pending == 0; });
+            job = nullptr;
+        }
+
+    private:
+        void workerMain(int w) {
+            uint64_t seen_generation = 0;
+            for (;;) {
+                const std::function<void(int, size_t, size_t)>* fn;
+                size_t count;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&] { return stopping || generation != seen_generation; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen_generation = generation;
+                    fn = job;
+                    count = job_count;
+                }
+                (*fn)(w, count * w / worker_count, count * (w + 1) / worker_count);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+
+        const int worker_count;
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable wake;       // A new job, or stopping
+        std::condition_variable done;       // pending reached 0
+        const std::function<void(int, size_t, size_t)>* job = nullptr;
+        size_t job_count = 0;
+        int pending = 0;                    // Workers still running the current job
+        uint64_t generation = 0;            // Incremented for every job
+        bool stopping = false;
+    };
+
+    // A task running on its own thread, for jobs the UI polls every frame. isRunning() turns false once the task
+    // has returned, and everything it wrote is visible then. Destroying the job cancels it and joins the thread, so
+    // declare it after the members the task uses.
+    class BackgroundJob {
+    public:
+        BackgroundJob() = default;
+        ~BackgroundJob() {
+            cancel();
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        BackgroundJob(const BackgroundJob&) = delete;
+        BackgroundJob& operator=(const BackgroundJob&) = delete;
+
+        // Runs fn on a new thread. A job is started once.
+        void start(std::function<void()> fn) {
+            running.store(true, std::memory_order_release);
+            thread = std::thread([this, fn = std::move(fn)] {
+                fn();
+                running.store(false, std::memory_order_release);
+            });
+        }
+        void cancel() { cancel_requested.store(true, std::memory_order_relaxed); }
+        bool isRunning() const { return running.load(std::memory_order_acquire); }
+        bool isCancelled() const { return cancel_requested.load(std::memory_order_relaxed); }
+        // For the task to poll, e.g. as the cancel argument of load_files_new() or export_rows()
+        const std::atomic<bool>* getCancelFlag() const { return &cancel_requested; }
+
+    private:
+        std::thread thread;
+        std::atomic<bool> running{ false };
+        std::atomic<bool> cancel_requested{ false };
+    };
+}
@@ -0,0 +1,159 @@
+#include "SortIndex.h"
+#include "Parallel.h"
+#include <algorithm>
+
+namespace LogParser {
+
+    // One 8-bit digit per pass. Every worker histograms its chunk, the histograms are turned into per-worker
+    // output offsets, then every worker scatters its chunk in order: the result is stable.
+    // Passes above the highest set bit of the largest key, and passes where every key has the same digit, are skipped.
+    void radix_sort_parallel(std::vector<uint64_t>* keys, std::vector<uint32_t>* values) {
+        const size_t count = keys->size();
+        if (count < 2) {
+            return;
+        }
+        WorkerPool pool(get_worker_count(count));
+        const int workers = pool.size();
+        uint64_t max_key = 0;
+        for (uint64_t k : *keys) {
+            max_key |= k;
+        }
+
+        std::vector<uint64_t> keys_tmp(count);
+        std::vector<uint32_t> values_tmp(count);
+        std::vector<size_t> offsets((size_t)workers * 256);
+        for (int shift = 0; shift < 64 && (max_key >> shift) != 0; shift += 8) {
+            const uint64_t* src_keys = keys->data();
+            const uint32_t* src_values = values->data();
+            std::fill(offsets.begin(), offsets.end(), 0);
+            pool.run(count, [&](int w, size_t begin, size_t end) {
+                size_t* hist = &offsets[(size_t)w * 256];
+                for (size_t i = begin; i < end; i++) {
+                    hist[(src_keys[i] >> shift) & 0xFF]++;
+                }
+            });
+
+            bool trivial = false;
+            size_t sum = 0;
+            for (int digit = 0; digit < 256; digit++) {
+                size_t digit_total = 0;
+                for (int w = 0; w < workers; w++) {
+                    size_t n = offsets[(size_t)w * 256 + digit];
+                    offsets[(size_t)w * 256 + digit] = sum;
+                    sum += n;
+                    digit_total += n;
+                }
+                trivial |= (digit_total == count);
+            }
+            if (trivial) {
+                continue;
+            }
+
+            uint64_t* dst_keys = keys_tmp.data();
+            uint32_t* dst_values = values_tmp.data();
+            pool.run(count, [&](int w, size_t begin, size_t end) {
+                size_t* offset = &offsets[(size_t)w * 256];
+                for (size_t i = begin; i < end; i++) {
+                    size_t dst = offset[(src_keys[i] >> shift) & 0xFF]++;
+                    dst_keys[dst] = src_keys[i];
+                    dst_values[dst] = src_values[i];
+                }
+            });
+            keys->swap(keys_tmp);
+            values->swap(values_tmp);
+        }
+    }
+
+    void SortIndex::clear() {
+        for (Entry& entry : entries) {
+            entry = Entry();
+        }
+        thread_rank.clear();
+    }
+
+    uint64_t SortIndex::getKey(const LogDetailNew& d, SortKey key) const {
+        switch (key) {
+        case SortKey_Id: return (uint64_t)d.id;
+        case SortKey_Time: return (uint64_t)(d.ts + 1); // Malformed (-1) first
+        case SortKey_Level: return (uint64_t)d.level;
+        case SortKey_Thread: return thread_rank.find(d.thread_name)->second;
+        default: return 0;
+        }
+    }
+
+    void SortIndex::buildKeys(const LogStats& stats, SortKey key, size_t begin, size_t end, std::vector<uint64_t>* out) const {
+        out->resize(end - begin);
+        uint64_t* dst = out->data();
+        const LogDetailNew* logs = stats.logs.data();
+        parallel_for_chunks(get_worker_count(end - begin), end - begin, [&](int, size_t chunk_begin, size_t chunk_end) {
+            for (size_t i = chunk_begin; i < chunk_end; i++) {
+                dst[i] = getKey(logs[begin + i], key);
+            }
+        });
+    }
+
+    const std::vector<uint32_t>& SortIndex::get(const LogStats& stats, SortKey key) {
+        Entry& entry = entries[key];
+        const size_t count = stats.logs.size();
+
+        // Thread names sort alphabetically; a new name shifts the ranks, so the whole permutation is rebuilt
+        if (key == SortKey_Thread && entry.thread_count != stats.thread_name_map.size()) {
+            std::vector<const std::string*> names;
+            for (const auto& kv : stats.thread_name_map) {
+                names.push_back(kv.second.get());
+            }
+            std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+            thread_rank.clear();
+            for (size_t i = 0; i < names.size(); i++) {
+                thread_rank[names[i]] = (uint32_t)i;
+            }
+            entry = Entry();
+            entry.thread_count = stats.thread_name_map.size();
+        }
+        if (entry.rows.size() > count) {
+            entry = Entry();
+        }
+        if (entry.rows.size() == count) {
+            return entry.rows;
+        }
+
+        // Sort the rows added since last time on their own
+        const size_t old_count = entry.rows.size();
+        std::vector<uint64_t> new_keys;
+        buildKeys(stats, key, old_count, count, &new_keys);
+        std::vector<uint32_t> new_rows(count - old_count);
+        for (size_t i = 0; i < new_rows.size(); i++) {
+            new_rows[i] = (uint32_t)(old_count + i);
+        }
+        radix_sort_parallel(&new_keys, &new_rows);
+
+        // Merge them in, reading the keys of the cached rows from their records. Rows usually arrive in time
+        // order, in which case this is an append.
+        const LogDetailNew* logs = stats.logs.data();
+        if (old_count == 0 || getKey(logs[entry.rows.back()], key) <= new_keys.front()) {
+            entry.rows.insert(entry.rows.end(), new_rows.begin(), new_rows.end());
+            return entry.rows;
+        }
+        std::vector<uint32_t> rows(count);
+        size_t a = 0, b = 0, dst = 0;
+        uint64_t key_a = getKey(logs[entry.rows[0]], key);
+        while (a < old_count && b < new_rows.size()) {
+            // Old rows have lower indices, so they win ties
+            if (new_keys[b] < key_a) {
+                rows[dst++] = new_rows[b++];
+            }
+            else {
+                rows[dst++] = entry.rows[a++];
+                key_a = a < old_count ? getKey(logs[entry.rows[a]], key) : 0;
+            }
+        }
+        for (; a < old_count; a++, dst++) {
+            rows[dst] = entry.rows[a];
+        }
+        for (; b < new_rows.size(); b++, dst++) {
+            rows[dst] = new_rows[b];
+        }
+        entry.rows.swap(rows);
+        return entry.rows;
+    }
+}
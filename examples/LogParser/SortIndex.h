@@ -0,0 +1,37 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    enum SortKey {
+        SortKey_Id,
+        SortKey_Time,
+        SortKey_Level,
+        SortKey_Thread,
+        SortKey_COUNT
+    };
+
+    // Stable ascending permutations of LogStats::logs, one per sort key, computed with a parallel LSD radix sort
+    // over a numeric key column and cached. When rows are appended only the new rows are sorted, then merged
+    // into the cached permutation. Ties keep row order, so a descending view is the permutation read backwards.
+    class SortIndex {
+    public:
+        const std::vector<uint32_t>& get(const LogStats& stats, SortKey key);
+        void clear();
+
+    private:
+        struct Entry {
+            std::vector<uint32_t> rows;     // Permutation of [0, rows.size()). Keys are read back from the records to merge.
+            size_t thread_count = 0;        // SortKey_Thread: ranks are only valid for this set of thread names
+        };
+
+        uint64_t getKey(const LogDetailNew& d, SortKey key) const;
+        void buildKeys(const LogStats& stats, SortKey key, size_t begin, size_t end, std::vector<uint64_t>* out) const;
+
+        Entry entries[SortKey_COUNT];
+        std::unordered_map<const std::string*, uint32_t> thread_rank;
+    };
+
+    // Sorts keys ascending and applies the same moves to values. Stable.
+    void radix_sort_parallel(std::vector<uint64_t>* keys, std::vector<uint32_t>* values);
+}
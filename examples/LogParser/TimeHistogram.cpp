@@ -0,0 +1,112 @@
+#include "TimeHistogram.h"
+
+namespace LogParser {
+
+    void TimeHistogram::clear() {
+        for (int k = 0; k < LevelCount; k++) {
+            levels[k].clear();
+        }
+        origin_ms = 0;
+        base_ms = 1000;
+        total = 0;
+        min_ts = max_ts = 0;
+    }
+
+    void TimeHistogram::add(int64_t ts, LogLevel level) {
+        if (ts < 0) {
+            return;
+        }
+        grow(ts);
+        for (int k = 0; k < LevelCount; k++) {
+            levels[k][(size_t)bucketIndex(k, ts) * LogLevel_COUNT + level]++;
+        }
+        min_ts = (total == 0 || ts < min_ts) ? ts : min_ts;
+        max_ts = (total == 0 || ts > max_ts) ? ts : max_ts;
+        total++;
+    }
+
+    void TimeHistogram::add(const LogDetailNew* logs, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            add(logs[i].ts, logs[i].level);
+        }
+    }
+
+    int64_t TimeHistogram::bucketMs(int level) const {
+        int64_t ms = base_ms;
+        for (int k = 0; k < level; k++) {
+            ms *= LevelFactor;
+        }
+        return ms;
+    }
+
+    int64_t TimeHistogram::bucketsPerTop(int level) const {
+        int64_t n = 1;
+        for (int k = level; k < LevelCount - 1; k++) {
+            n *= LevelFactor;
+        }
+        return n;
+    }
+
+    int TimeHistogram::pickLevel(double min_bucket_ms) const {
+        for (int k = 0; k < LevelCount; k++) {
+            if ((double)bucketMs(k) >= min_bucket_ms) {
+                return k;
+            }
+        }
+        return LevelCount - 1;
+    }
+
+    // Make sure ts falls inside the covered range. The range is always a whole number of top-level buckets.
+    void TimeHistogram::grow(int64_t ts) {
+        const int64_t top_ms = bucketMs(LevelCount - 1);
+        if (levels[0].empty()) {
+            origin_ms = ts / top_ms * top_ms;
+            addTopBuckets(0, 1);
+        }
+        else if (ts < origin_ms) {
+            addTopBuckets((origin_ms - ts + top_ms - 1) / top_ms, 0);
+        }
+        else {
+            const int64_t end_ms = origin_ms + bucketCount(LevelCount - 1) * top_ms;
+            if (ts >= end_ms) {
+                addTopBuckets(0, (ts - end_ms) / top_ms + 1);
+            }
+        }
+
+        while (bucketCount(0) > MaxBaseBuckets) {
+            coarsen();
+        }
+    }
+
+    void TimeHistogram::addTopBuckets(int64_t front, int64_t back) {
+        for (int k = 0; k < LevelCount; k++) {
+            const size_t per_top = (size_t)bucketsPerTop(k) * LogLevel_COUNT;
+            levels[k].insert(levels[k].begin(), (size_t)front * per_top, 0);
+            levels[k].insert(levels[k].end(), (size_t)back * per_top, 0);
+        }
+        origin_ms -= front * bucketMs(LevelCount - 1);
+    }
+
+    // Drop the finest level and add a LevelFactor times coarser one on top.
+    void TimeHistogram::coarsen() {
+        // Align the range on the future top-level bucket size first
+        const int64_t top_ms = bucketMs(LevelCount - 1);
+        const int64_t new_top_ms = top_ms * LevelFactor;
+        const int64_t front = (origin_ms % new_top_ms) / top_ms;
+        addTopBuckets(front, 0);
+        const int64_t rem = bucketCount(LevelCount - 1) % LevelFactor;
+        addTopBuckets(0, rem ? LevelFactor - rem : 0);
+
+        for (int k = 0; k < LevelCount - 1; k++) {
+            levels[k].swap(levels[k + 1]);
+        }
+        const std::vector<uint32_t>& below = levels[LevelCount - 2];
+        std::vector<uint32_t>& top = levels[LevelCount - 1];
+        top.assign(below.size() / LevelFactor, 0);
+        for (size_t i = 0; i < below.size(); i++) {
+            const size_t bucket = i / LogLevel_COUNT;
+            top[bucket / LevelFactor * LogLevel_COUNT + i % LogLevel_COUNT] += below[i];
+        }
+        base_ms *= LevelFactor;
+    }
+}
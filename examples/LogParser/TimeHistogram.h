@@ -0,0 +1,48 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    // Log volume over time, stacked by level, as a pyramid of bucket counts.
+    // Level 0 has the finest buckets and every level above merges LevelFactor buckets of the one below,
+    // so any zoom is drawn from the level whose buckets are about one pixel wide, without touching the rows.
+    // Records may arrive in any time order: the covered range grows on both sides. When the finest level
+    // would exceed MaxBaseBuckets it is dropped and a coarser level is added on top.
+    class TimeHistogram {
+    public:
+        static const int LevelCount = 10;
+        static const int LevelFactor = 4;
+        static const int64_t MaxBaseBuckets = 1024 * 1024;
+
+        void clear();
+        void add(int64_t ts, LogLevel level);
+        void add(const LogDetailNew* logs, size_t count);
+
+        bool empty() const { return total == 0; }
+        int64_t getTotal() const { return total; }
+        int64_t getMinTs() const { return min_ts; }
+        int64_t getMaxTs() const { return max_ts; }
+
+        int64_t bucketMs(int level) const;
+        int64_t bucketCount(int level) const { return (int64_t)levels[level].size() / LogLevel_COUNT; }
+        int64_t bucketStart(int level, int64_t i) const { return origin_ms + i * bucketMs(level); }
+        int64_t bucketIndex(int level, int64_t ts) const { return (ts - origin_ms) / bucketMs(level); }
+        const uint32_t* bucket(int level, int64_t i) const { return &levels[level][(size_t)i * LogLevel_COUNT]; }
+
+        // Finest level whose buckets are at least min_bucket_ms wide (the coarsest level if none is).
+        int pickLevel(double min_bucket_ms) const;
+
+    private:
+        int64_t bucketsPerTop(int level) const;
+        void grow(int64_t ts);
+        void addTopBuckets(int64_t front, int64_t back);
+        void coarsen();
+
+        std::vector<uint32_t> levels[LevelCount];
+        int64_t origin_ms = 0;
+        int64_t base_ms = 1000;
+        int64_t total = 0;
+        int64_t min_ts = 0;
+        int64_t max_ts = 0;
+    };
+}
@@ -0,0 +1,84 @@
+#include "ViewMinimap.h"
+#include "Parallel.h"
+
+namespace LogParser {
+
+    static inline void set_bit(std::vector<uint64_t>* bits, uint32_t row) {
+        if (row / 64 >= bits->size()) {
+            bits->resize(row / 64 + 1, 0);
+        }
+        (*bits)[row / 64] |= (uint64_t)1 << (row % 64);
+    }
+
+    static inline bool test_bit(const std::vector<uint64_t>& bits, uint32_t row) {
+        return row / 64 < bits.size() && (bits[row / 64] >> (row % 64)) & 1;
+    }
+
+    void ViewMinimap::addRows(const LogStats& stats) {
+        for (size_t row = row_count; row < stats.logs.size(); row++) {
+            const LogLevel level = stats.logs[row].level;
+            if (level == LogLevel_Err) {
+                set_bit(&bits[MinimapLane_Err], (uint32_t)row);
+            }
+            else if (level == LogLevel_Wrn) {
+                set_bit(&bits[MinimapLane_Wrn], (uint32_t)row);
+            }
+        }
+        row_count = stats.logs.size();
+    }
+
+    void ViewMinimap::setFindRows(const std::vector<LogDetailNew>& logs) {
+        bits[MinimapLane_Find].clear();
+        for (const LogDetailNew& d : logs) {
+            set_bit(&bits[MinimapLane_Find], (uint32_t)d.id);
+        }
+        dirty = true;
+    }
+
+    void ViewMinimap::clear() {
+        for (std::vector<uint64_t>& b : bits) {
+            b.clear();
+        }
+        row_count = 0;
+        counts.clear();
+        view_size = 0;
+        bucket_count = 0;
+        non_empty = 0;
+        dirty = true;
+    }
+
+    bool ViewMinimap::update(const std::vector<uint32_t>& view, int max_buckets) {
+        if (!dirty && max_buckets == max_bucket_count) {
+            return false;
+        }
+        dirty = false;
+        max_bucket_count = max_buckets;
+        view_size = view.size();
+        bucket_count = (int)std::min((size_t)std::max(max_buckets, 0), view_size);
+        counts.assign((size_t)bucket_count * MinimapLane_COUNT, 0);
+
+        // Workers take contiguous ranges of buckets, which are contiguous ranges of the view: no merging
+        const int workers = std::min(get_worker_count(view_size), std::max(bucket_count, 1));
+        std::vector<int> worker_non_empty(workers, 0);
+        parallel_for_chunks(workers, (size_t)bucket_count, [&](int w, size_t first_bucket, size_t last_bucket) {
+            for (size_t b = first_bucket; b < last_bucket; b++) {
+                uint32_t* out = &counts[b * MinimapLane_COUNT];
+                const size_t end = bucketBegin((int)b + 1);
+                for (size_t i = bucketBegin((int)b); i < end; i++) {
+                    const uint32_t row = view[i];
+                    for (int lane = 0; lane < MinimapLane_COUNT; lane++) {
+                        out[lane] += test_bit(bits[lane], row);
+                    }
+                }
+                for (int lane = 0; lane < MinimapLane_COUNT; lane++) {
+                    worker_non_empty[w] += out[lane] > 0;
+                }
+            }
+        });
+        non_empty = 0;
+        for (int n : worker_non_empty) {
+            non_empty += n;
+        }
+        return true;
+    }
+}
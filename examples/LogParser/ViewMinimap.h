@@ -0,0 +1,50 @@
+#pragma once
+#include "LogParser.h"
+
+namespace LogParser {
+
+    enum MinimapLane {
+        MinimapLane_Err,
+        MinimapLane_Wrn,
+        MinimapLane_Find,
+        MinimapLane_COUNT
+    };
+
+    // Density of errors, warnings and Find matches along a view, one bucket per pixel of the minimap strip.
+    // Rows are tested against bitmaps indexed by row id, so the buckets only depend on the view order and are
+    // recomputed when the view or the bucket count changes, not every frame.
+    class ViewMinimap {
+    public:
+        // Extends the level bitmaps with the rows appended to stats since the last call.
+        void addRows(const LogStats& stats);
+        // Find matches, as copies of rows of the dataset (LogDetailNew::id is the row).
+        void setFindRows(const std::vector<LogDetailNew>& logs);
+        void clear();
+
+        // The next update() recomputes the buckets.
+        void invalidate() { dirty = true; }
+        // Recomputes the buckets if invalidated or if max_buckets changed. Returns true if it did.
+        bool update(const std::vector<uint32_t>& view, int max_buckets);
+
+        // min(max_buckets, view size)
+        int bucketCount() const { return bucket_count; }
+        size_t viewSize() const { return view_size; }
+        // Rows in bucket i, and rows of each lane
+        uint32_t bucketRows(int i) const { return (uint32_t)(bucketBegin(i + 1) - bucketBegin(i)); }
+        const uint32_t* bucket(int i) const { return &counts[(size_t)i * MinimapLane_COUNT]; }
+        // Buckets with at least one row in a lane, summed over the lanes, for reserving draw primitives.
+        int nonEmptyCount() const { return non_empty; }
+
+    private:
+        size_t bucketBegin(int i) const { return (size_t)((uint64_t)i * view_size / bucket_count); }
+
+        std::vector<uint64_t> bits[MinimapLane_COUNT];
+        size_t row_count = 0;                   // Rows covered by the level bitmaps
+        std::vector<uint32_t> counts;           // bucket_count * MinimapLane_COUNT
+        size_t view_size = 0;
+        int bucket_count = 0;
+        int max_bucket_count = 0;
+        int non_empty = 0;
+        bool dirty = true;
+    };
+}
@@ -1,7 +1,16 @@
 #include "Application.h"
 #include "imgui.h"
 #include <vector>
+#include <algorithm>
 #include <examples/LogParser/LogParser.h>
+#include <examples/LogParser/TimeHistogram.h>
+#include <examples/LogParser/SortIndex.h>
+#include <examples/LogParser/LogFilter.h>
+#include <examples/LogParser/GroupBy.h>
+#include <examples/LogParser/Export.h>
+#include <examples/LogParser/LogDiff.h>
+#include <examples/LogParser/Bookmarks.h>
+#include <examples/LogParser/ViewMinimap.h>
 #include <iostream>
 #include <filesystem>
 #include <thread>
@@ -10,12 +19,7 @@
 namespace fs = std::filesystem;
 
 
-struct Filter {
-    char str[1024] = { 0 };
-    std::unordered_map<std::string, boost::regex> pattern_map;
-    bool is_case_sensitive = false;
-    bool is_regex_error = false;
-};
+using LogParser::Filter;
 
 struct FindInfo {
     Filter filter;
@@ -26,27 +30,94 @@ struct FindInfo {
 class Application
 {
 private:
-    LogParser::LogStats db;
     LogParser::LogStats original_db;
-    LogParser::LogStats new_db;
+
+    // Rows shown in LogTable, as indices into original_db.logs
+    std::vector<uint32_t> filter_rows;          // Rows matching filter, ascending
+    std::vector<uint64_t> filter_bits;          // Same rows as a bitmap, to compose with the sort permutations
+    std::vector<uint32_t> sorted_rows;          // filter_rows in table sort order, when a sort is active
+    LogParser::SortIndex sort_index;
+    LogParser::SortKey sort_key = LogParser::SortKey_Id;
+    bool sort_active = false;
+    bool sort_descending = false;
+    bool view_dirty = false;
+    bool scroll_to_top = false;
     bool show_demo_window = false;
     bool show_log_window = true;
     bool show_import_window = false;
+    bool show_export_window = false;
+    bool show_diff_window = false;
     Filter filter;
     Filter detail_filter;
-    ImVector<long> selected_logs;
+    ImGuiSelectionStorage selection;            // Selected LogTable rows, as positions in viewRows(). Remapped when the sort changes, cleared by a new filter.
+    std::string copy_status;                    // Result of the last Ctrl+C in LogTable, shown until the selection changes
+    long selected_id = -1;                      // Row shown in the detail viewer: last clicked or navigated to
+    int64_t selected_pos = -1;                  // View position of selected_id, -1 if unknown
+
+    // Detail viewer: the selected record, split in lines once when the selection changes
+    long detail_id = -1;
+    std::string detail_text;                    // File name + content
+    std::vector<size_t> detail_line_starts;
+    std::vector<uint32_t> detail_line_rows;     // Wrapped row count per line, 0 until the line was visible
+    float detail_wrap_width = -1;
 
     long scroll_to_id = -1;
+    int64_t scroll_to_pos = -1;                 // View position of scroll_to_id if known, saves searching the view
     bool scrolled = true;
     float item_height = -1;
     float clipper_display_item_size = -1;
 
+    // Expanded rows: LogTable shows every line of multi-line records, the clipper reads the row heights from row_heights
+    bool expand_rows = false;
+    ImGuiListClipperHeights row_heights;        // Per view position, appended to as the view grows
+    bool row_heights_dirty = true;              // row_heights must be rebuilt for a new view
+    float row_heights_line_height = -1;         // Text line height row_heights were computed with
+
     // File Loading related
-    LogParser::LoadFileStats load_stats;
-    LogParser::LoadFileStats original_load_stats;
+    std::unique_ptr<LogParser::ImportJob> import_job;
+    std::unique_ptr<LogParser::ExportJob> export_job;  // Reads original_db: finished or destroyed before original_db changes
+
+    // Diff: a second set of logs compared against original_db
+    LogParser::LogStats compare_db;
+    std::unique_ptr<LogParser::ImportJob> compare_job;
+    std::unique_ptr<LogParser::DiffJob> diff_job;      // Reads original_db and compare_db, same rule as export_job
+    std::vector<uint32_t> diff_rows[LogParser::DiffKey_COUNT];  // Rows of the diff result, in table order
+    int diff_sort_column = 3;
+    bool diff_sort_descending = true;
+    bool diff_dirty = false;
 
     FindInfo find_info;
 
+    // Timeline
+    LogParser::TimeHistogram histogram;         // All rows
+    LogParser::TimeHistogram view_histogram;    // Rows matching the current filter
+    int64_t timeline_begin = 0;                 // Visible time range, begin == end means the whole dataset
+    int64_t timeline_end = 0;
+
+    // Patterns
+    std::vector<uint32_t> pattern_counts;       // Rows per template id
+    std::vector<uint32_t> pattern_rows;         // Template ids in Patterns tab order
+    bool pattern_sort_by_text = false;
+    bool pattern_sort_descending = true;
+    bool patterns_dirty = false;
+    int64_t pattern_filter = -1;                // Only rows of this template are shown, -1 for all
+
+    // Bookmarks
+    LogParser::Bookmarks bookmarks;
+    std::vector<uint32_t> bookmark_positions;   // View positions of the bookmarks, ascending
+    bool bookmarks_dirty = false;               // bookmark_positions must be recomputed for a new view
+
+    // Error, warning and Find match density along the view, next to LogTable
+    LogParser::ViewMinimap minimap;
+
+    // Group By
+    LogParser::GroupBy group_by;                // Over filter_rows
+    std::vector<uint32_t> group_rows;           // Keys of the non-empty groups, in table order
+    int group_sort_column = 1;
+    bool group_sort_descending = true;
+    bool groups_dirty = false;
+    double group_update_ms = 0.0;
+
 public:
     Application() {}
 
@@ -61,10 +132,8 @@ public:
     {
         ImGui::DockSpaceOverViewport(ImGui::GetMainViewport());
 
-        if (original_db.logs.size() != new_db.logs.size()) {
-            original_db = new_db;
-            db = new_db;
-        }
+        pollImportJob();
+        pollCompareJob();
 
         if (show_demo_window) {
             ImGui::ShowDemoWindow(&show_demo_window);
@@ -80,6 +149,14 @@ public:
             ShowImportWindow();
         }
 
+        if (show_export_window) {
+            ShowExportWindow();
+        }
+
+        if (show_diff_window) {
+            ShowDiffWindow();
+        }
+
         ShowLoadingModal();
     }
 
@@ -96,6 +173,16 @@ public:
                 ImGui::EndMenu();
             }
 
+            if (ImGui::BeginMenu("Export")) {
+                show_export_window = true;
+                ImGui::EndMenu();
+            }
+
+            if (ImGui::BeginMenu("Diff")) {
+                show_diff_window = true;
+                ImGui::EndMenu();
+            }
+
             if (ImGui::BeginMenu("Demo")) {
                 show_demo_window = true;
                 ImGui::EndMenu();
@@ -108,27 +195,65 @@ public:
     {
         ImGui::Begin("Log Viewer", &show_log_window);
 
-        bool scroll_to_top = false;
+        if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows)) {
+            if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_B)) {
+                toggleBookmark();
+            }
+            if (ImGui::IsKeyChordPressed(ImGuiKey_F2)) {
+                jumpToBookmark(true);
+            }
+            if (ImGui::IsKeyChordPressed(ImGuiMod_Shift | ImGuiKey_F2)) {
+                jumpToBookmark(false);
+            }
+        }
+
         if (ImGui::InputTextWithHint("Filter", "Filter", filter.str, IM_ARRAYSIZE(filter.str), ImGuiInputTextFlags_EnterReturnsTrue)) {
-            parseFilter(&filter);
+            LogParser::parseFilter(&filter);
 
             if (!filter.is_regex_error) {
-                db.logs.clear();
-                resetFindWindow();
-                scroll_to_top = true;
-
-                boost::smatch matches;
-                for (const LogParser::LogDetailNew& info : original_db.logs) {
-                    if (isLineMatchFilter(info, filter, matches)) {
-                        db.logs.push_back(info);
-                    }
-                }
+                applyFilter();
             }
         }
 
         ImGui::SameLine();
         ImGui::Checkbox("Case Sensitive", &filter.is_case_sensitive);
 
+        ImGui::SameLine();
+        ImGui::Checkbox("Expand Rows", &expand_rows);
+        ImGui::SetItemTooltip("Show every line of multi-line records (up to %d)", MaxExpandedLines);
+
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##prev_bookmark", ImGuiDir_Left)) {
+            jumpToBookmark(false);
+        }
+        ImGui::SetItemTooltip("Previous bookmark (Shift+F2)");
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##next_bookmark", ImGuiDir_Right)) {
+            jumpToBookmark(true);
+        }
+        ImGui::SetItemTooltip("Next bookmark (F2)");
+        ImGui::SameLine();
+        ImGui::TextDisabled("%d/%d bookmarks in view (Ctrl+B)", (int)bookmark_positions.size(), (int)bookmarks.size());
+        if (!copy_status.empty()) {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.0f, 1.0f), "%s", copy_status.c_str());
+        }
+
+        if (pattern_filter >= 0) {
+            ImGui::SameLine();
+            if (ImGui::SmallButton("x##pattern_filter")) {
+                pattern_filter = -1;
+                applyFilter();
+            }
+            else {
+                ImGui::SameLine();
+                ImGui::TextDisabled("Pattern:");
+                ImGui::SameLine();
+                const std::string& text = original_db.templates[pattern_filter];
+                ImGui::TextUnformatted(text.data(), text.data() + text.size());
+            }
+        }
+
         ImGui::Spacing();
 
         if (filter.is_regex_error) {
@@ -136,86 +261,129 @@ public:
             ImGui::Spacing();
         }
 
+        ShowTimeline();
+
         ImGui::BeginChild("ChildL", ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y * 0.7f), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
 
-        ImGui::BeginChild("##cliptest", ImVec2(0, 0));
+        const float minimap_width = ImGui::GetFontSize();
+        // Large scroll: tens of millions of rows are taller than float positions can address precisely
+        ImGui::BeginChild("##cliptest", ImVec2(std::max(ImGui::GetContentRegionAvail().x - minimap_width - ImGui::GetStyle().ItemSpacing.x, 1.0f), 0), ImGuiChildFlags_LargeScrollY);
 
         if (scroll_to_top) {
-            ImGui::SetScrollY(0);
+            scroll_to_top = false;
+            ImGui::SetLargeScrollY(0);
         }
         else {
             if (item_height > 0 && clipper_display_item_size > 0 && !scrolled) {
                 scrolled = true;
 
+                const std::vector<uint32_t>& rows = viewRows();
                 int target_row;
-                for (target_row = 0; target_row < db.logs.size(); target_row++) {
-                    if (db.logs[target_row].id == scroll_to_id) {
-                        break;
+                if (scroll_to_pos >= 0 && scroll_to_pos < (int64_t)rows.size() && original_db.logs[rows[scroll_to_pos]].id == scroll_to_id) {
+                    target_row = (int)scroll_to_pos;
+                }
+                else {
+                    for (target_row = 0; target_row < (int)rows.size(); target_row++) {
+                        if (original_db.logs[rows[target_row]].id == scroll_to_id) {
+                            break;
+                        }
                     }
                 }
 
-                float scroll_y;
-                if (target_row - (clipper_display_item_size / 2) < 0) {
+                double scroll_y;
+                if (expand_rows && target_row < row_heights.Size()) {
+                    const double target_y = row_heights.GetPosition(target_row) + row_heights.GetHeight(target_row) / 2;
+                    scroll_y = std::max(0.0, target_y - clipper_display_item_size * item_height / 2);
+                }
+                else if (target_row - (clipper_display_item_size / 2) < 0) {
                     scroll_y = 0;
                 }
                 else {
-                    scroll_y = (target_row - (clipper_display_item_size / 2)) * item_height;
+                    scroll_y = (target_row - (clipper_display_item_size / 2)) * (double)item_height;
                 }
 
-                ImGui::SetScrollY(scroll_y);
+                ImGui::SetLargeScrollY(scroll_y);
             }
         }
 
-        if (ImGui::BeginTable("LogTable", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable))
+        if (ImGui::BeginTable("LogTable", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate))
         {
-            ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_DefaultHide);
-            ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed);
-            ImGui::TableSetupColumn("Lv", ImGuiTableColumnFlags_WidthFixed);
-            ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed);
-            ImGui::TableSetupColumn("Content", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_DefaultHide, 0.0f, LogParser::SortKey_Id);
+            ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, 0.0f, LogParser::SortKey_Time);
+            ImGui::TableSetupColumn("Lv", ImGuiTableColumnFlags_WidthFixed, 0.0f, LogParser::SortKey_Level);
+            ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed, 0.0f, LogParser::SortKey_Thread);
+            ImGui::TableSetupColumn("Content", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_NoSort);
             ImGui::TableHeadersRow();
 
-            int x = 0;
+            if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
+                if (sort_specs->SpecsDirty) {
+                    sort_active = sort_specs->SpecsCount > 0;
+                    if (sort_active) {
+                        sort_key = (LogParser::SortKey)sort_specs->Specs[0].ColumnUserID;
+                        sort_descending = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+                    }
+                    view_dirty = true;
+                    sort_specs->SpecsDirty = false;
+                }
+            }
+            if (view_dirty) {
+                rebuildSortedView();
+            }
+            if (bookmarks_dirty) {
+                bookmarks_dirty = false;
+                bookmarks.getViewPositions(viewRows(), !sort_active, &bookmark_positions);
+            }
 
+            // Click, Ctrl+Click, Shift+Click, Shift+Arrows and Ctrl+A come back as range requests over view positions,
+            // so selecting across rows the clipper never submitted costs the same as selecting one row.
+            const std::vector<uint32_t>& rows = viewRows();
+            ImGuiMultiSelectIO* ms_io = ImGui::BeginMultiSelect(ImGuiMultiSelectFlags_ClearOnEscape, (int)rows.size());
+            selection.ApplyRequests(ms_io);
+            if (ms_io->Requests.Size > 0) {
+                copy_status.clear();
+            }
             ImGuiListClipper clipper;
-            clipper.Begin(db.logs.size());
+            if (expand_rows) {
+                updateRowHeights(rows);
+                clipper.Begin(&row_heights);
+            }
+            else {
+                clipper.Begin((int)rows.size());
+            }
             while (clipper.Step()) {
                 for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
                 {
                     ImGui::TableNextRow();
-                    const LogParser::LogDetailNew* d = &db.logs[i];
+                    const LogParser::LogDetailNew* d = &original_db.logs[rows[i]];
                     if (ImGui::TableSetColumnIndex(0)) {
                         ImGui::Text("%ld", d->id);
                     }
                     if (ImGui::TableSetColumnIndex(1)) {
-                        const bool item_is_selected = selected_logs.contains(d->id) && scroll_to_id != d->id;
-                        char label[128];
-                        snprintf(label, sizeof(label), "%s##%ld", d->dt.c_str(), d->id);
-                        if (ImGui::Selectable(label, item_is_selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0))) {
-                            selected_logs.clear();
-                            selected_logs.push_back(d->id);
+                        const bool item_is_selected = selection.Contains(i) && scroll_to_id != d->id;
+                        ImGui::PushID((int)d->id);
+                        ImGui::SetNextItemSelectionUserData(i);
+                        if (ImGui::Selectable(d->dt.c_str(), item_is_selected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0))) {
+                            selected_id = d->id;
+                            selected_pos = i;
                         }
+                        ImGui::PopID();
                     }
                     if (ImGui::TableSetColumnIndex(2)) {
-                        ImGui::Text("%s", d->prority.c_str());
+                        ImGui::TextUnformatted(d->prority.data(), d->prority.data() + d->prority.size());
                     }
                     if (ImGui::TableSetColumnIndex(3)) {
-                        ImGui::Text("%s", d->thread_name->c_str());
+                        ImGui::TextUnformatted(d->thread_name->data(), d->thread_name->data() + d->thread_name->size());
                     }
                     if (ImGui::TableSetColumnIndex(4)) {
-                        char str[512] = { 0 };
-                        const char* src = d->content.c_str();
-                        size_t k = 0;
-                        while (k < sizeof(str) && src[k] != '\0' && src[k] != '\n') {
-                            str[k] = src[k];
-                            k++;
-                        }
-                        ImGui::Text("%s", str);
+                        ImGui::TextUnformatted(d->content.data(), expand_rows ? getContentExpandedEnd(*d, nullptr) : getContentPreviewEnd(*d));
                     }
 
                     if (scroll_to_id == d->id) {
                         ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, IM_COL32(255, 255, 0, 128));
                     }
+                    else if (bookmarks.contains(rows[i])) {
+                        ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, IM_COL32(80, 140, 255, 90));
+                    }
 
                     if (clipper.ItemsHeight > 0) {
                         item_height = clipper.ItemsHeight;
@@ -224,65 +392,59 @@ public:
                 }
             }
             clipper.End();
+            ms_io = ImGui::EndMultiSelect();
+            selection.ApplyRequests(ms_io);
+            if (ms_io->Requests.Size > 0) {
+                copy_status.clear();
+            }
             ImGui::EndTable();
         }
 
+        if (ImGui::IsWindowFocused() && ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_C)) {
+            copySelection();
+        }
+
         ImGui::EndChild();
 
+        ImGui::SameLine();
+        ShowMinimap(minimap_width);
+
         ImGui::EndChild();
 
         ImGui::Spacing();
 
-        static char text[1024 * 1024] = {};
-        if (selected_logs.size() > 0) {
-            int id = selected_logs[0];
-            for (const LogParser::LogDetailNew& info : original_db.logs) {
-                if (info.id == id) {
-                    std::string s = std::string(*info.file_name);
-                    s += "\n";
-                    s += info.content;
-                    strncpy(text, s.c_str(), 1024 * 1024);
-                    break;
-                }
-            }
-        }
+        updateDetailText();
 
         ImGui::BeginChild("ChildL1", ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y),
             ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar | ImGuiChildFlags_Border | ImGuiChildFlags_ResizeX);
 
         if (ImGui::BeginTabBar("##Tabs", ImGuiTabBarFlags_None)) {
             if (ImGui::BeginTabItem("Info")) {
-                if (selected_logs.size() > 0) {
-                    ImGui::TextWrapped(text);
-                }
-                else {
-                    ImGui::TextWrapped("");
-                }
+                ShowDetailWrapped();
                 ImGui::EndTabItem();
             }
 
             if (ImGui::BeginTabItem("Raw")) {
-                ImGui::InputTextMultiline("##source", text, IM_ARRAYSIZE(text), ImGui::GetContentRegionAvail(), ImGuiInputTextFlags_AllowTabInput);
-
+                ShowDetailRaw();
                 ImGui::EndTabItem();
             }
 
             if (ImGui::BeginTabItem("Find")) {
                 if (ImGui::InputTextWithHint("Filter", "Filter", find_info.filter.str, IM_ARRAYSIZE(find_info.filter.str), ImGuiInputTextFlags_EnterReturnsTrue)) {
-                    parseFilter(&find_info.filter);
+                    LogParser::parseFilter(&find_info.filter);
 
                     if (!find_info.filter.is_regex_error) {
                         ImGui::SetScrollY(0);
                         find_info.log_stats.logs.clear();
 
                         boost::smatch matches;
-                        for (const LogParser::LogDetailNew& info : original_db.logs) {
-                            if (isLineMatchFilter(info, filter, matches)) {
-                                if (isLineMatchFilter(info, find_info.filter, matches)) {
-                                    find_info.log_stats.logs.push_back(info);
-                                }
+                        for (uint32_t row : filter_rows) {
+                            const LogParser::LogDetailNew& info = original_db.logs[row];
+                            if (LogParser::isLineMatchFilter(info, find_info.filter, matches)) {
+                                find_info.log_stats.logs.push_back(info);
                             }
                         }
+                        minimap.setFindRows(find_info.log_stats.logs);
                     }
                 }
 
@@ -317,33 +479,26 @@ public:
                             }
 
                             if (ImGui::TableSetColumnIndex(1)) {
-                                char label[128];
-                                snprintf(label, sizeof(label), "%s##%ld", d->dt.c_str(), d->id);
-                                if (ImGui::Selectable(label, false, ImGuiSelectableFlags_SpanAllColumns, ImVec2(0, 0))) {
+                                ImGui::PushID((int)d->id);
+                                if (ImGui::Selectable(d->dt.c_str(), false, ImGuiSelectableFlags_SpanAllColumns, ImVec2(0, 0))) {
                                     scroll_to_id = d->id;
                                     scrolled = false;
-                                    selected_logs.clear();
-                                    selected_logs.push_back(d->id);
+                                    selection.Clear();
+                                    selected_id = d->id;
                                 }
+                                ImGui::PopID();
                             }
 
                             if (ImGui::TableSetColumnIndex(2)) {
-                                ImGui::Text("%s", d->prority.c_str());
+                                ImGui::TextUnformatted(d->prority.data(), d->prority.data() + d->prority.size());
                             }
 
                             if (ImGui::TableSetColumnIndex(3)) {
-                                ImGui::Text("%s", d->thread_name->c_str());
+                                ImGui::TextUnformatted(d->thread_name->data(), d->thread_name->data() + d->thread_name->size());
                             }
 
                             if (ImGui::TableSetColumnIndex(4)) {
-                                char str[512] = { 0 };
-                                const char* src = d->content.c_str();
-                                size_t k = 0;
-                                while (k < sizeof(str) && src[k] != '\0' && src[k] != '\n') {
-                                    str[k] = src[k];
-                                    k++;
-                                }
-                                ImGui::Text("%s", str);
+                                ImGui::TextUnformatted(d->content.data(), getContentPreviewEnd(*d));
                             }
                         }
                     }
@@ -356,6 +511,21 @@ public:
                 ImGui::EndTabItem();
             }
 
+            if (ImGui::BeginTabItem("Patterns")) {
+                ShowPatternsTab();
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Group By")) {
+                ShowGroupByTab();
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Bookmarks")) {
+                ShowBookmarksTab();
+                ImGui::EndTabItem();
+            }
+
             ImGui::EndTabBar();
         }
 
@@ -364,6 +534,536 @@ public:
         ImGui::End();
     }
 
+    // Selected record with its lines wrapped. Only the visible lines are laid out: a line counts as one row
+    // until it has been visible once, then its wrapped row count is kept until the width changes.
+    void ShowDetailWrapped() {
+        ImGui::BeginChild("ChildDetailInfo", ImGui::GetContentRegionAvail());
+        const float wrap_width = ImGui::GetContentRegionAvail().x;
+        if (wrap_width != detail_wrap_width) {
+            detail_wrap_width = wrap_width;
+            std::fill(detail_line_rows.begin(), detail_line_rows.end(), 0);
+        }
+
+        // Every line is one item: its rows plus the item spacing
+        const float line_height = ImGui::GetTextLineHeight();
+        const float spacing = ImGui::GetStyle().ItemSpacing.y;
+        const float visible_begin = ImGui::GetScrollY();
+        const float visible_end = visible_begin + ImGui::GetWindowHeight();
+        const size_t line_count = detail_line_starts.size();
+        float y = 0.0f;
+        size_t line = 0;
+        for (; line < line_count; line++) {
+            const float h = std::max(detail_line_rows[line], 1u) * line_height + spacing;
+            if (y + h > visible_begin) {
+                break;
+            }
+            y += h;
+        }
+        if (y > 0.0f) {
+            ImGui::Dummy(ImVec2(0.0f, y - spacing));
+        }
+
+        ImGui::PushTextWrapPos(0.0f);
+        for (; line < line_count && y < visible_end; line++) {
+            const char* begin;
+            const char* end;
+            getDetailLine(line, &begin, &end);
+            if (detail_line_rows[line] == 0) {
+                const float text_height = ImGui::CalcTextSize(begin, end, false, wrap_width).y;
+                detail_line_rows[line] = std::max((uint32_t)(text_height / line_height + 0.5f), 1u);
+            }
+            ImGui::TextUnformatted(begin, end);
+            y += detail_line_rows[line] * line_height + spacing;
+        }
+        ImGui::PopTextWrapPos();
+
+        float rest = 0.0f;
+        for (; line < line_count; line++) {
+            rest += std::max(detail_line_rows[line], 1u) * line_height + spacing;
+        }
+        if (rest > 0.0f) {
+            ImGui::Dummy(ImVec2(0.0f, rest - spacing));
+        }
+        ImGui::EndChild();
+    }
+
+    // Selected record, one line per row, not wrapped. Read-only: Copy puts the whole record on the clipboard.
+    void ShowDetailRaw() {
+        if (ImGui::SmallButton("Copy")) {
+            ImGui::SetClipboardText(detail_text.c_str());
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("%d lines, %d bytes", (int)detail_line_starts.size(), (int)detail_text.size());
+
+        ImGui::BeginChild("ChildDetailRaw", ImGui::GetContentRegionAvail(), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)detail_line_starts.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const char* begin;
+                const char* end;
+                getDetailLine(i, &begin, &end);
+                ImGui::TextUnformatted(begin, end);
+            }
+        }
+        clipper.End();
+        ImGui::EndChild();
+    }
+
+    // Strip next to LogTable with the whole view mapped to its height. Error, warning and Find match density
+    // are drawn in three lanes from the minimap buckets, which are only recomputed when the view or the strip
+    // height changes. Bookmarks are drawn as ticks from bookmark_positions, so the cost depends on the number
+    // of bookmarks, not rows. Hovering a tick shows its note, clicking it jumps to the row.
+    void ShowMinimap(float width) {
+        const ImVec2 size(width, std::max(ImGui::GetContentRegionAvail().y, 1.0f));
+        const ImVec2 p0 = ImGui::GetCursorScreenPos();
+        const ImVec2 p1(p0.x + size.x, p0.y + size.y);
+        ImGui::InvisibleButton("##minimap", size);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddRectFilled(p0, p1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+        const std::vector<uint32_t>& rows = viewRows();
+        minimap.update(rows, (int)size.y);
+        drawMinimapDensity(draw_list, p0, size);
+        if (rows.empty() || bookmark_positions.empty()) {
+            return;
+        }
+        const float px_per_row = size.y / rows.size();
+        for (uint32_t pos : bookmark_positions) {
+            const float y = std::floor(p0.y + (pos + 0.5f) * px_per_row);
+            draw_list->AddRectFilled(ImVec2(p0.x, y - 1.0f), ImVec2(p1.x, y + 1.0f), IM_COL32(80, 140, 255, 255));
+        }
+
+        if (ImGui::IsItemHovered()) {
+            // Nearest tick within a few pixels of the mouse
+            const float mouse_y = ImGui::GetIO().MousePos.y;
+            const int64_t mouse_pos = (int64_t)((mouse_y - p0.y) / px_per_row);
+            auto it = std::lower_bound(bookmark_positions.begin(), bookmark_positions.end(), (uint32_t)std::max(mouse_pos, (int64_t)0));
+            int64_t best = -1;
+            float best_dist = 4.0f;
+            for (auto c : { it, it == bookmark_positions.begin() ? it : it - 1 }) {
+                if (c != bookmark_positions.end()) {
+                    const float dist = std::abs(p0.y + (*c + 0.5f) * px_per_row - mouse_y);
+                    if (dist <= best_dist) {
+                        best = *c;
+                        best_dist = dist;
+                    }
+                }
+            }
+            if (best >= 0) {
+                const LogParser::LogDetailNew& d = original_db.logs[rows[best]];
+                const std::string& note = bookmarks.getNote(rows[best]);
+                ImGui::SetTooltip("#%ld %s\n%s", d.id, d.dt.c_str(), note.c_str());
+                if (ImGui::IsItemClicked()) {
+                    jumpToViewPosition(best);
+                }
+            }
+        }
+    }
+
+    // One rectangle per non-empty (bucket, lane), all written after a single PrimReserve(). The alpha follows the
+    // share of the bucket's rows in the lane, with a floor so that a single hit stays visible.
+    void drawMinimapDensity(ImDrawList* draw_list, const ImVec2& p0, const ImVec2& size) {
+        static const ImU32 lane_colors[LogParser::MinimapLane_COUNT] = {
+            IM_COL32(230, 60, 60, 0),       // Err
+            IM_COL32(230, 190, 60, 0),      // Wrn
+            IM_COL32(80, 220, 120, 0),      // Find
+        };
+        const int bucket_count = minimap.bucketCount();
+        const int rect_count = minimap.nonEmptyCount();
+        if (bucket_count == 0 || rect_count == 0) {
+            return;
+        }
+        const float lane_width = size.x / LogParser::MinimapLane_COUNT;
+        const float px_per_bucket = size.y / bucket_count;
+        const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+        draw_list->PrimReserve(rect_count * 6, rect_count * 4);
+        for (int b = 0; b < bucket_count; b++) {
+            const uint32_t* counts = minimap.bucket(b);
+            const uint32_t bucket_rows = minimap.bucketRows(b);
+            const float y0 = p0.y + b * px_per_bucket;
+            const float y1 = p0.y + (b + 1) * px_per_bucket;
+            for (int lane = 0; lane < LogParser::MinimapLane_COUNT; lane++) {
+                if (counts[lane] == 0) {
+                    continue;
+                }
+                const int alpha = 96 + (int)(159.0f * counts[lane] / bucket_rows);
+                const float x0 = p0.x + lane * lane_width;
+                draw_list->PrimRectUV(ImVec2(x0, y0), ImVec2(x0 + lane_width, y1), uv, uv, lane_colors[lane] | ((ImU32)alpha << IM_COL32_A_SHIFT));
+            }
+        }
+    }
+
+    // Bookmarked rows in id order, with an editable note each. Bookmarks filtered out of the view are greyed.
+    void ShowBookmarksTab() {
+        ImGui::TextDisabled("Ctrl+B toggles the selected row, F2/Shift+F2 jump to the next/previous bookmark in view");
+        ImGui::BeginChild("ChildBookmarksTab", ImGui::GetContentRegionAvail(), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+        if (ImGui::BeginTable("bookmark_table", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable)) {
+            ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("Note", ImGuiTableColumnFlags_WidthFixed, ImGui::GetFontSize() * 16);
+            ImGui::TableSetupColumn("Content", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableHeadersRow();
+
+            const std::vector<uint32_t>& bookmark_rows = bookmarks.getRows();
+            int64_t remove_row = -1;
+            ImGuiListClipper clipper;
+            clipper.Begin((int)bookmark_rows.size());
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const uint32_t row = bookmark_rows[i];
+                    const LogParser::LogDetailNew& d = original_db.logs[row];
+                    const bool in_view = row / 64 < filter_bits.size() && (filter_bits[row / 64] >> (row % 64)) & 1;
+                    ImGui::TableNextRow();
+                    ImGui::PushID((int)row);
+                    if (ImGui::TableSetColumnIndex(0)) {
+                        ImGui::Text("%ld", d.id);
+                    }
+                    if (ImGui::TableSetColumnIndex(1)) {
+                        ImGui::BeginDisabled(!in_view);
+                        if (ImGui::Selectable(d.dt.c_str(), false, ImGuiSelectableFlags_AllowOverlap)) {
+                            scroll_to_id = d.id;
+                            scroll_to_pos = -1;
+                            scrolled = false;
+                            selection.Clear();
+                            selected_id = d.id;
+                            selected_pos = -1;
+                        }
+                        ImGui::EndDisabled();
+                    }
+                    if (ImGui::TableSetColumnIndex(2)) {
+                        char note[256];
+                        snprintf(note, sizeof(note), "%s", bookmarks.getNote(row).c_str());
+                        ImGui::SetNextItemWidth(-FLT_MIN);
+                        if (ImGui::InputTextWithHint("##note", "Note", note, IM_ARRAYSIZE(note))) {
+                            bookmarks.setNote(row, note);
+                        }
+                    }
+                    if (ImGui::TableSetColumnIndex(3)) {
+                        ImGui::TextUnformatted(d.content.data(), getContentPreviewEnd(d));
+                    }
+                    if (ImGui::TableSetColumnIndex(4)) {
+                        if (ImGui::SmallButton("x")) {
+                            remove_row = row;
+                        }
+                    }
+                    ImGui::PopID();
+                }
+            }
+            clipper.End();
+            ImGui::EndTable();
+
+            if (remove_row >= 0) {
+                bookmarks.toggle((uint32_t)remove_row);
+                bookmarks_dirty = true;
+            }
+        }
+        ImGui::EndChild();
+    }
+
+    // Message templates found while importing, with their row counts. Clicking one shows only its rows
+    // in LogTable, clicking it again shows all rows.
+    void ShowPatternsTab() {
+        ImGui::Text("%d patterns", (int)original_db.templates.size());
+
+        ImGui::BeginChild("ChildPatternsTab", ImGui::GetContentRegionAvail(), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+        if (ImGui::BeginTable("pattern_table", 2, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable)) {
+            ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 0);
+            ImGui::TableSetupColumn("Pattern", ImGuiTableColumnFlags_WidthStretch, 0.0f, 1);
+            ImGui::TableHeadersRow();
+
+            if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
+                if (sort_specs->SpecsDirty && sort_specs->SpecsCount > 0) {
+                    pattern_sort_by_text = sort_specs->Specs[0].ColumnUserID == 1;
+                    pattern_sort_descending = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+                    patterns_dirty = true;
+                    sort_specs->SpecsDirty = false;
+                }
+            }
+            if (patterns_dirty) {
+                rebuildPatternRows();
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int)pattern_rows.size());
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const uint32_t id = pattern_rows[i];
+                    const std::string& text = original_db.templates[id];
+                    ImGui::TableNextRow();
+                    if (ImGui::TableSetColumnIndex(0)) {
+                        char count[16];
+                        snprintf(count, sizeof(count), "%u", pattern_counts[id]);
+                        ImGui::PushID((int)id);
+                        if (ImGui::Selectable(count, pattern_filter == id, ImGuiSelectableFlags_SpanAllColumns, ImVec2(0, 0))) {
+                            pattern_filter = pattern_filter == id ? -1 : (int64_t)id;
+                            applyFilter();
+                        }
+                        ImGui::PopID();
+                    }
+                    if (ImGui::TableSetColumnIndex(1)) {
+                        ImGui::TextUnformatted(text.data(), text.data() + text.size());
+                    }
+                }
+            }
+            clipper.End();
+            ImGui::EndTable();
+        }
+        ImGui::EndChild();
+    }
+
+    // Row count, count per level and time range of the rows in the current view, per thread, level, file or pattern.
+    // Only computed while the tab is open; rows added by a running import are aggregated as they arrive.
+    void ShowGroupByTab() {
+        static const char* key_names[LogParser::GroupKey_COUNT] = { "Thread", "Level", "File", "Pattern" };
+        int key = group_by.getKey();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10);
+        if (ImGui::Combo("Group By", &key, key_names, IM_ARRAYSIZE(key_names))) {
+            group_by.setKey((LogParser::GroupKey)key);
+        }
+
+        const int64_t t0 = LogParser::now_ns();
+        if (group_by.update(original_db, filter_rows)) {
+            group_update_ms = (LogParser::now_ns() - t0) / 1e6;
+            groups_dirty = true;
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("%d rows, %d groups (%.1f ms)", (int)filter_rows.size(), (int)group_rows.size(), group_update_ms);
+
+        ImGui::BeginChild("ChildGroupByTab", ImGui::GetContentRegionAvail(), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+        if (ImGui::BeginTable("group_table", 6, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable)) {
+            ImGui::TableSetupColumn(key_names[key], ImGuiTableColumnFlags_WidthStretch, 0.0f, 0);
+            ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 1);
+            ImGui::TableSetupColumn("ERR", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 2);
+            ImGui::TableSetupColumn("WRN", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 3);
+            ImGui::TableSetupColumn("First", ImGuiTableColumnFlags_WidthFixed, 0.0f, 4);
+            ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthFixed, 0.0f, 5);
+            ImGui::TableHeadersRow();
+
+            if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
+                if (sort_specs->SpecsDirty && sort_specs->SpecsCount > 0) {
+                    group_sort_column = (int)sort_specs->Specs[0].ColumnUserID;
+                    group_sort_descending = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+                    groups_dirty = true;
+                    sort_specs->SpecsDirty = false;
+                }
+            }
+            if (groups_dirty) {
+                rebuildGroupRows();
+            }
+
+            const std::vector<LogParser::GroupBy::Group>& groups = group_by.getGroups();
+            ImGuiListClipper clipper;
+            clipper.Begin((int)group_rows.size());
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const LogParser::GroupBy::Group& g = groups[group_rows[i]];
+                    ImGui::TableNextRow();
+                    if (ImGui::TableSetColumnIndex(0)) {
+                        const std::string label = group_by.getLabel(original_db, group_rows[i]);
+                        ImGui::TextUnformatted(label.data(), label.data() + label.size());
+                    }
+                    if (ImGui::TableSetColumnIndex(1)) {
+                        ImGui::Text("%llu", (unsigned long long)g.count);
+                    }
+                    if (ImGui::TableSetColumnIndex(2)) {
+                        ImGui::Text("%llu", (unsigned long long)g.level_counts[LogParser::LogLevel_Err]);
+                    }
+                    if (ImGui::TableSetColumnIndex(3)) {
+                        ImGui::Text("%llu", (unsigned long long)g.level_counts[LogParser::LogLevel_Wrn]);
+                    }
+                    char ts_str[32];
+                    if (ImGui::TableSetColumnIndex(4)) {
+                        LogParser::format_timestamp(g.first_ts, ts_str, sizeof(ts_str));
+                        ImGui::TextUnformatted(ts_str);
+                    }
+                    if (ImGui::TableSetColumnIndex(5)) {
+                        LogParser::format_timestamp(g.last_ts, ts_str, sizeof(ts_str));
+                        ImGui::TextUnformatted(ts_str);
+                    }
+                }
+            }
+            clipper.End();
+            ImGui::EndTable();
+        }
+        ImGui::EndChild();
+    }
+
+    // Log volume over time, stacked by level. Grey bars are all rows, colored bars the rows matching the filter.
+    // Mouse wheel zooms, dragging pans, clicking jumps to the first matching row at that time, right-click resets.
+    void ShowTimeline() {
+        const float height = ImGui::GetTextLineHeight() * 4.0f;
+        const ImVec2 size(std::max(ImGui::GetContentRegionAvail().x, 1.0f), height);
+        const ImVec2 p0 = ImGui::GetCursorScreenPos();
+        const ImVec2 p1(p0.x + size.x, p0.y + size.y);
+        ImGui::InvisibleButton("##timeline", size, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddRectFilled(p0, p1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+        if (histogram.empty()) {
+            return;
+        }
+
+        if (timeline_begin >= timeline_end) {
+            timeline_begin = histogram.getMinTs();
+            timeline_end = std::max(histogram.getMaxTs() + 1, timeline_begin + 1000);
+        }
+        const double ms_per_px = (double)(timeline_end - timeline_begin) / size.x;
+
+        ImGuiIO& io = ImGui::GetIO();
+        const int64_t mouse_ts = timeline_begin + (int64_t)((io.MousePos.x - p0.x) * ms_per_px);
+        if (ImGui::IsItemHovered()) {
+            if (io.MouseWheel != 0.0f) {
+                const double zoom = io.MouseWheel > 0.0f ? 0.8 : 1.25;
+                timeline_begin = mouse_ts - (int64_t)((mouse_ts - timeline_begin) * zoom);
+                timeline_end = std::max(mouse_ts + (int64_t)((timeline_end - mouse_ts) * zoom), timeline_begin + 10);
+            }
+            if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && ImGui::GetMouseDragDelta(ImGuiMouseButton_Left).x == 0.0f) {
+                jumpToTime(mouse_ts);
+            }
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Right)) {
+                timeline_begin = timeline_end = 0;
+            }
+        }
+        if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
+            const int64_t delta = (int64_t)(-io.MouseDelta.x * ms_per_px);
+            timeline_begin += delta;
+            timeline_end += delta;
+        }
+
+        // Scale both passes on the tallest visible bar of the unfiltered histogram
+        uint32_t max_count = 1;
+        const int level = histogram.pickLevel(ms_per_px);
+        int64_t first, last;
+        getVisibleBuckets(histogram, level, &first, &last);
+        for (int64_t i = first; i < last; i++) {
+            max_count = std::max(max_count, sumLevels(histogram.bucket(level, i)));
+        }
+        const float scale_y = height / max_count;
+
+        draw_list->PushClipRect(p0, p1, true);
+        drawTimelineBars(draw_list, histogram, ms_per_px, p0, scale_y, false);
+        drawTimelineBars(draw_list, view_histogram, ms_per_px, p0, scale_y, true);
+        draw_list->PopClipRect();
+
+        if (ImGui::IsItemHovered() && !ImGui::IsItemActive()) {
+            const int64_t i = histogram.bucketIndex(level, mouse_ts);
+            if (mouse_ts >= histogram.bucketStart(level, 0) && i < histogram.bucketCount(level)) {
+                char begin_str[32], end_str[32];
+                LogParser::format_timestamp(histogram.bucketStart(level, i), begin_str, sizeof(begin_str));
+                LogParser::format_timestamp(histogram.bucketStart(level, i + 1), end_str, sizeof(end_str));
+                const uint32_t* counts = histogram.bucket(level, i);
+                ImGui::SetTooltip("%s - %s\nERR %u  WRN %u  INF %u  DBG %u  other %u", begin_str, end_str,
+                    counts[LogParser::LogLevel_Err], counts[LogParser::LogLevel_Wrn], counts[LogParser::LogLevel_Inf], counts[LogParser::LogLevel_Dbg], counts[LogParser::LogLevel_Other]);
+            }
+        }
+    }
+
+    void getVisibleBuckets(const LogParser::TimeHistogram& hist, int level, int64_t* first, int64_t* last) {
+        *first = std::max(hist.bucketIndex(level, std::max(timeline_begin, hist.bucketStart(level, 0))), (int64_t)0);
+        *last = std::min(hist.bucketIndex(level, std::max(timeline_end, hist.bucketStart(level, 0))) + 1, hist.bucketCount(level));
+    }
+
+    // One bar per bucket, from the pyramid level whose buckets are about one pixel wide.
+    void drawTimelineBars(ImDrawList* draw_list, const LogParser::TimeHistogram& hist, double ms_per_px, ImVec2 p0, float scale_y, bool stacked) {
+        static const ImU32 level_colors[LogParser::LogLevel_COUNT] = {
+            IM_COL32(230, 60, 60, 255), IM_COL32(230, 170, 40, 255), IM_COL32(70, 150, 230, 255), IM_COL32(140, 140, 140, 255), IM_COL32(170, 110, 220, 255)
+        };
+        if (hist.empty()) {
+            return;
+        }
+        const int level = hist.pickLevel(ms_per_px);
+        const float bottom = p0.y + ImGui::GetTextLineHeight() * 4.0f;
+        const ImU32 total_color = ImGui::GetColorU32(ImGuiCol_TextDisabled, 0.35f);
+        int64_t first, last;
+        getVisibleBuckets(hist, level, &first, &last);
+        for (int64_t i = first; i < last; i++) {
+            const float x0 = p0.x + (float)((hist.bucketStart(level, i) - timeline_begin) / ms_per_px);
+            const float x1 = std::max(x0 + 1.0f, p0.x + (float)((hist.bucketStart(level, i + 1) - timeline_begin) / ms_per_px));
+            const uint32_t* counts = hist.bucket(level, i);
+            if (!stacked) {
+                const uint32_t sum = sumLevels(counts);
+                if (sum > 0) {
+                    draw_list->AddRectFilled(ImVec2(x0, bottom - sum * scale_y), ImVec2(x1, bottom), total_color);
+                }
+                continue;
+            }
+            float y = bottom;
+            for (int lv = 0; lv < LogParser::LogLevel_COUNT; lv++) {
+                if (counts[lv] > 0) {
+                    const float h = counts[lv] * scale_y;
+                    draw_list->AddRectFilled(ImVec2(x0, y - h), ImVec2(x1, y), level_colors[lv]);
+                    y -= h;
+                }
+            }
+        }
+    }
+
+    static uint32_t sumLevels(const uint32_t* counts) {
+        uint32_t sum = 0;
+        for (int lv = 0; lv < LogParser::LogLevel_COUNT; lv++) {
+            sum += counts[lv];
+        }
+        return sum;
+    }
+
+    // Bookmarks or un-bookmarks the selected row.
+    void toggleBookmark() {
+        if (selected_id < 0 || selected_id >= (long)original_db.logs.size()) {
+            return;
+        }
+        // Row ids are row indices in original_db
+        const uint32_t row = (uint32_t)selected_id;
+        const bool added = bookmarks.toggle(row);
+        const std::vector<uint32_t>& rows = viewRows();
+        if (selected_pos < 0 || selected_pos >= (int64_t)rows.size() || rows[selected_pos] != row) {
+            bookmarks_dirty = true;
+            return;
+        }
+        auto it = std::lower_bound(bookmark_positions.begin(), bookmark_positions.end(), (uint32_t)selected_pos);
+        if (added) {
+            bookmark_positions.insert(it, (uint32_t)selected_pos);
+        }
+        else if (it != bookmark_positions.end() && *it == (uint32_t)selected_pos) {
+            bookmark_positions.erase(it);
+        }
+    }
+
+    // Selects and scrolls to the next (or previous) bookmark in view from the selected row, wrapping around.
+    void jumpToBookmark(bool forward) {
+        const int64_t pos = LogParser::find_next_bookmark(bookmark_positions, selected_pos, forward);
+        if (pos >= 0) {
+            jumpToViewPosition(pos);
+        }
+    }
+
+    void jumpToViewPosition(int64_t pos) {
+        const LogParser::LogDetailNew& d = original_db.logs[viewRows()[pos]];
+        scroll_to_id = d.id;
+        scroll_to_pos = pos;
+        scrolled = false;
+        selection.Clear();
+        selected_id = d.id;
+        selected_pos = pos;
+    }
+
+    // Selects and scrolls to the earliest row of the current view at or after ts.
+    void jumpToTime(int64_t ts) {
+        const LogParser::LogDetailNew* best = nullptr;
+        for (uint32_t row : viewRows()) {
+            const LogParser::LogDetailNew& info = original_db.logs[row];
+            if (info.ts >= ts && (best == nullptr || info.ts < best->ts)) {
+                best = &info;
+            }
+        }
+        if (best != nullptr) {
+            scroll_to_id = best->id;
+            scrolled = false;
+            selection.Clear();
+            selected_id = best->id;
+        }
+    }
+
     void ShowImportWindow() {
         ImGui::Begin("Import", &show_import_window);
 
@@ -382,6 +1082,49 @@ public:
         ImGui::SameLine();
         ImGui::InputText("Log Directory", dir_str, IM_ARRAYSIZE(dir_str));
 
+        // Header line format: detected per file, a builtin one, or a custom pattern
+        static int format_index = -1;
+        static char pattern_str[256] = "[{level} {thread},{time}]:{message}";
+        static int layout = LogParser::TimestampLayout_MonthDay;
+        const std::vector<LogParser::LogFormat>& formats = LogParser::get_builtin_log_formats();
+        const int custom_index = (int)formats.size();
+        const char* preview = format_index < 0 ? "Auto-detect" : format_index == custom_index ? "Custom" : formats[format_index].name.c_str();
+        if (ImGui::BeginCombo("Format", preview)) {
+            if (ImGui::Selectable("Auto-detect", format_index < 0)) {
+                format_index = -1;
+            }
+            for (int i = 0; i < custom_index; i++) {
+                if (ImGui::Selectable(formats[i].name.c_str(), format_index == i)) {
+                    format_index = i;
+                }
+                ImGui::SetItemTooltip("%s", formats[i].pattern.c_str());
+            }
+            if (ImGui::Selectable("Custom", format_index == custom_index)) {
+                format_index = custom_index;
+            }
+            ImGui::EndCombo();
+        }
+        LogParser::LogFormat custom_format;
+        std::string format_error;
+        bool format_ok = true;
+        if (format_index == custom_index) {
+            ImGui::InputText("Pattern", pattern_str, IM_ARRAYSIZE(pattern_str));
+            ImGui::SetItemTooltip("Fields: {level} {thread} {skip} {time} {message}, or \"json\". A space matches one or more spaces.");
+            const char* layout_names[LogParser::TimestampLayout_COUNT];
+            for (int i = 0; i < LogParser::TimestampLayout_COUNT; i++) {
+                layout_names[i] = LogParser::get_timestamp_layout_name((LogParser::TimestampLayout)i);
+            }
+            ImGui::Combo("Timestamp", &layout, layout_names, IM_ARRAYSIZE(layout_names));
+            custom_format.name = "Custom";
+            custom_format.pattern = pattern_str;
+            custom_format.timestamp_layout = (LogParser::TimestampLayout)layout;
+            format_ok = LogParser::LogScanner().compile(custom_format, &format_error);
+            if (!format_ok) {
+                ImGui::TextColored(ImVec4(0.8f, 0.0f, 0.0f, 1.0f), "%s", format_error.c_str());
+            }
+        }
+        const LogParser::LogFormat* format = format_index < 0 ? nullptr : format_index == custom_index ? &custom_format : &formats[format_index];
+
         ImGui::BeginChild("left pane", ImVec2(150, 0), ImGuiChildFlags_Border | ImGuiChildFlags_ResizeX);
         if (ImGui::Button("Stage All")) {
             for (int i = 0; i < left_files.size(); i++) {
@@ -409,7 +1152,7 @@ public:
 
         ImGui::BeginChild("right pane", ImVec2(0, 0), ImGuiChildFlags_Border);
 
-        if (ImGui::Button("Load Logs")) {
+        auto get_paths = [&]() {
             std::vector<std::string> paths;
             std::string dir = std::string(dir_str);
             if (dir.back() != '\\' && dir.back() != '/') {
@@ -419,11 +1162,17 @@ public:
                 std::string p = dir + right_files[i];
                 paths.push_back(p);
             }
-
-            resetLogWindow();
-            std::thread writer(&writerThread, std::ref(load_stats), std::ref(new_db), paths);
-            writer.detach();
+            return paths;
+        };
+        ImGui::BeginDisabled(!format_ok);
+        if (ImGui::Button("Load Logs")) {
+            startImport(get_paths(), format);
         }
+        ImGui::SameLine();
+        if (ImGui::Button("Load as Comparison")) {
+            startCompareImport(get_paths(), format);
+        }
+        ImGui::EndDisabled();
 
         remove_i = -1;
         for (int i = 0; i < right_files.size(); i++) {
@@ -441,28 +1190,234 @@ public:
         ImGui::End();
     }
 
+    // Writes the rows of LogTable, in table order, on a background thread.
+    void ShowExportWindow() {
+        ImGui::Begin("Export", &show_export_window);
+
+        static char path_str[1024] = "export.log";
+        static int format = LogParser::ExportFormat_Raw;
+        static const char* format_names[LogParser::ExportFormat_COUNT] = { "Raw lines", "CSV", "NDJSON" };
+        ImGui::InputText("File", path_str, IM_ARRAYSIZE(path_str));
+        ImGui::Combo("Format", &format, format_names, IM_ARRAYSIZE(format_names));
+
+        const bool exporting = export_job != nullptr && export_job->isRunning();
+        const std::vector<uint32_t>& rows = viewRows();
+        char label[64];
+        snprintf(label, sizeof(label), "Export %d rows", (int)rows.size());
+        ImGui::BeginDisabled(import_job != nullptr || exporting || rows.empty());
+        if (ImGui::Button(label)) {
+            export_job = std::make_unique<LogParser::ExportJob>(&original_db, rows, path_str, (LogParser::ExportFormat)format);
+            export_job->start();
+        }
+        ImGui::EndDisabled();
+        if (import_job != nullptr) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("Waiting for the import to finish");
+        }
+
+        if (export_job != nullptr) {
+            const LogParser::ExportStats& stats = export_job->export_stats;
+            const int64_t rows_written = stats.rows_written.load(std::memory_order_relaxed);
+            const int64_t total_rows = stats.total_rows.load(std::memory_order_relaxed);
+            const double mb = stats.bytes_written.load(std::memory_order_relaxed) / (1024.0 * 1024.0);
+            const int64_t start = stats.start_ns.load(std::memory_order_relaxed);
+            const int64_t end = stats.end_ns.load(std::memory_order_relaxed);
+            const double elapsed = start == 0 ? 0.0 : ((end != 0 ? end : LogParser::now_ns()) - start) / 1e9;
+
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%lld / %lld rows", (long long)rows_written, (long long)total_rows);
+            ImGui::ProgressBar(total_rows > 0 ? (float)((double)rows_written / total_rows) : 0.0f, ImVec2(300.0f, 0.0f), overlay);
+            ImGui::Text("%.1f MB, %.1f MB/s", mb, elapsed > 0.0 ? mb / elapsed : 0.0);
+
+            if (exporting) {
+                if (export_job->isCancelled()) {
+                    ImGui::TextDisabled("Cancelling...");
+                }
+                else if (ImGui::Button("Cancel")) {
+                    export_job->cancel();
+                }
+            }
+            else if (!export_job->hasSucceeded()) {
+                ImGui::TextColored(ImVec4(0.8f, 0.0f, 0.0f, 1.0f), "%s", export_job->getError().c_str());
+            }
+            else if (export_job->isCancelled()) {
+                ImGui::Text("Cancelled, %s is incomplete", export_job->getPath().c_str());
+            }
+            else {
+                ImGui::Text("Wrote %s in %.2fs", export_job->getPath().c_str(), elapsed);
+            }
+        }
+        ImGui::End();
+    }
+
+    // Compares original_db (A) with logs loaded through "Load as Comparison" (B) per pattern, thread and level.
+    // Times are offsets from the first record of each run, so runs from different days line up.
+    void ShowDiffWindow() {
+        ImGui::Begin("Diff", &show_diff_window);
+
+        const bool diffing = diff_job != nullptr && diff_job->isRunning();
+        ImGui::Text("A: %d rows, B: %d rows", (int)original_db.logs.size(), (int)compare_db.logs.size());
+        ImGui::BeginDisabled(import_job != nullptr || compare_job != nullptr || diffing || original_db.logs.empty() || compare_db.logs.empty());
+        if (ImGui::Button("Compare")) {
+            diff_job = std::make_unique<LogParser::DiffJob>(&original_db, &compare_db);
+            diff_job->start();
+            diff_dirty = true;
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        if (import_job != nullptr || compare_job != nullptr) {
+            ImGui::TextDisabled("Waiting for the import to finish");
+        }
+        else if (compare_db.logs.empty()) {
+            ImGui::TextDisabled("Load logs with \"Load as Comparison\" in the Import window");
+        }
+        else if (diffing) {
+            ImGui::TextDisabled("Comparing...");
+        }
+        else if (diff_job != nullptr) {
+            ImGui::TextDisabled("%.2fs, %llds buckets", diff_job->getSeconds(), (long long)(diff_job->result.bucket_ms / 1000));
+        }
+
+        if (diff_job == nullptr || diffing) {
+            ImGui::End();
+            return;
+        }
+        const LogParser::LogDiff& diff = diff_job->result;
+        static const char* key_names[LogParser::DiffKey_COUNT] = { "Pattern", "Thread", "Level" };
+        if (ImGui::BeginTabBar("DiffTabBar")) {
+            for (int k = 0; k < LogParser::DiffKey_COUNT; k++) {
+                if (ImGui::BeginTabItem(key_names[k])) {
+                    ShowDiffTable(diff, (LogParser::DiffKey)k, key_names[k]);
+                    ImGui::EndTabItem();
+                }
+            }
+            ImGui::EndTabBar();
+        }
+        ImGui::End();
+    }
+
+    void ShowDiffTable(const LogParser::LogDiff& diff, LogParser::DiffKey key, const char* key_name) {
+        if (!ImGui::BeginTable("diff_table", 7, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY)) {
+            return;
+        }
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn(key_name, ImGuiTableColumnFlags_WidthStretch, 0.0f, 0);
+        ImGui::TableSetupColumn("A", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 1);
+        ImGui::TableSetupColumn("B", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 2);
+        ImGui::TableSetupColumn("Share", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 3);
+        ImGui::TableSetupColumn("First A", ImGuiTableColumnFlags_WidthFixed, 0.0f, 4);
+        ImGui::TableSetupColumn("First B", ImGuiTableColumnFlags_WidthFixed, 0.0f, 5);
+        ImGui::TableSetupColumn("Peak", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, 6);
+        ImGui::TableHeadersRow();
+
+        if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) {
+            if (sort_specs->SpecsDirty && sort_specs->SpecsCount > 0) {
+                diff_sort_column = (int)sort_specs->Specs[0].ColumnUserID;
+                diff_sort_descending = sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+                diff_dirty = true;
+                sort_specs->SpecsDirty = false;
+            }
+        }
+        std::vector<uint32_t>& rows = diff_rows[key];
+        if (diff_dirty || rows.size() != diff.rows[key].size()) {
+            rebuildDiffRows(diff);
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const LogParser::DiffRow& r = diff.rows[key][rows[i]];
+                ImGui::TableNextRow();
+                if (ImGui::TableSetColumnIndex(0)) {
+                    ImGui::TextUnformatted(r.label.data(), r.label.data() + r.label.size());
+                }
+                for (int s = 0; s < 2; s++) {
+                    if (ImGui::TableSetColumnIndex(1 + s)) {
+                        ImGui::Text("%llu", (unsigned long long)r.count[s]);
+                    }
+                }
+                if (ImGui::TableSetColumnIndex(3)) {
+                    const double share = getDiffShareChange(diff, r);
+                    const ImVec4 color = share > 0.0 ? ImVec4(0.9f, 0.4f, 0.3f, 1.0f) : ImVec4(0.4f, 0.8f, 0.4f, 1.0f);
+                    ImGui::TextColored(share == 0.0 ? ImGui::GetStyleColorVec4(ImGuiCol_Text) : color, "%+.2f%%", share);
+                }
+                for (int s = 0; s < 2; s++) {
+                    if (ImGui::TableSetColumnIndex(4 + s)) {
+                        if (r.first_offset_ms[s] >= 0) {
+                            ImGui::Text("+%.1fs", r.first_offset_ms[s] / 1000.0);
+                        }
+                        else {
+                            ImGui::TextDisabled("-");
+                        }
+                    }
+                }
+                if (ImGui::TableSetColumnIndex(6)) {
+                    if (r.peak_delta != 0) {
+                        ImGui::Text("%+lld at +%llds", (long long)r.peak_delta, (long long)(r.peak_offset_ms / 1000));
+                    }
+                    else {
+                        ImGui::TextDisabled("-");
+                    }
+                }
+            }
+        }
+        clipper.End();
+        ImGui::EndTable();
+    }
+
+    // Change of the key's share of all rows from A to B, in percentage points.
+    static double getDiffShareChange(const LogParser::LogDiff& diff, const LogParser::DiffRow& r) {
+        const double a = diff.total[0] > 0 ? 100.0 * r.count[0] / diff.total[0] : 0.0;
+        const double b = diff.total[1] > 0 ? 100.0 * r.count[1] / diff.total[1] : 0.0;
+        return b - a;
+    }
+
+    // Not a modal: rows already received stay browsable while the import continues.
     void ShowLoadingModal() {
-        if (load_stats.loading) {
-            ImGui::OpenPopup("Importing...");
+        if (import_job == nullptr || !import_job->isRunning()) {
+            return;
         }
+        const LogParser::LoadFileStats& load_stats = import_job->stats;
 
         // Always center this window when appearing
         ImVec2 center = ImGui::GetMainViewport()->GetCenter();
         ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
 
-        if (ImGui::BeginPopupModal("Importing...", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        if (ImGui::Begin("Importing...", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDocking))
         {
-            char s[1024];
-            sprintf(s, "Files Loaded: %d/%d", load_stats.cur_file_count, load_stats.total_file_count);
-            ImGui::Text(s);
-            ImGui::Text(load_stats.cur_file_name.c_str());
-
-            if (!load_stats.loading) {
-                ImGui::CloseCurrentPopup();
+            const double elapsed = LogParser::elapsed_seconds(load_stats);
+            const int64_t bytes_read = load_stats.bytes_read.load(std::memory_order_relaxed);
+            const int64_t total_bytes = load_stats.total_bytes.load(std::memory_order_relaxed);
+            const int64_t lines_parsed = load_stats.lines_parsed.load(std::memory_order_relaxed);
+            const double mb_per_s = elapsed > 0.0 ? bytes_read / (1024.0 * 1024.0) / elapsed : 0.0;
+            const double lines_per_s = elapsed > 0.0 ? lines_parsed / elapsed : 0.0;
+
+            ImGui::Text("Files Loaded: %d/%d", load_stats.cur_file_count.load(), load_stats.total_file_count.load());
+            ImGui::Text("%s (%s)", load_stats.getCurFileName().c_str(), load_stats.getCurFormatName().c_str());
+
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%.1f / %.1f MB", bytes_read / (1024.0 * 1024.0), total_bytes / (1024.0 * 1024.0));
+            ImGui::ProgressBar(total_bytes > 0 ? (float)((double)bytes_read / total_bytes) : 0.0f, ImVec2(300.0f, 0.0f), overlay);
+
+            ImGui::Text("%.1f MB/s, %.0f lines/s", mb_per_s, lines_per_s);
+            ImGui::Text("Records: %lld", (long long)load_stats.records_emitted.load(std::memory_order_relaxed));
+            if (bytes_read > 0 && total_bytes > bytes_read) {
+                const double eta = (total_bytes - bytes_read) * elapsed / bytes_read;
+                ImGui::Text("Elapsed: %.1fs, ETA: %.1fs", elapsed, eta);
+            }
+            else {
+                ImGui::Text("Elapsed: %.1fs", elapsed);
             }
 
-            ImGui::EndPopup();
+            if (import_job->isCancelled()) {
+                ImGui::TextDisabled("Cancelling...");
+            }
+            else if (ImGui::Button("Cancel")) {
+                import_job->cancel();
+            }
         }
+        ImGui::End();
     }
 private:
 
@@ -476,139 +1431,416 @@ private:
         return true;
     }
 
-    void resetLogWindow() {
-        db = {};
-        original_db = {};
-        resetFindWindow();
+    // Cancels (and waits for) any running import before starting the new one, so two loaders never
+    // feed the same tables, and any running export, which reads them.
+    void startImport(const std::vector<std::string>& paths, const LogParser::LogFormat* format = nullptr) {
+        import_job.reset();
+        export_job.reset();
+        diff_job.reset();
+        resetLogWindow();
+        import_job = std::make_unique<LogParser::ImportJob>(paths, format);
+        import_job->start();
     }
 
-    void resetFindWindow() {
-        scroll_to_id = -1;
-        scrolled = true;
+    // Loads the logs compared against original_db in the Diff window. They are not shown in LogTable.
+    void startCompareImport(const std::vector<std::string>& paths, const LogParser::LogFormat* format = nullptr) {
+        compare_job.reset();
+        diff_job.reset();
+        compare_db = {};
+        compare_job = std::make_unique<LogParser::ImportJob>(paths, format);
+        compare_job->start();
     }
 
+    // Appends the batches published by the loader since last frame. A cancelled import keeps what it
+    // had already parsed.
+    void pollImportJob() {
+        if (import_job == nullptr) {
+            return;
+        }
+        const bool running = import_job->isRunning();
+
+        for (const auto& batch : import_job->takeBatches()) {
+            const size_t first_new_row = original_db.logs.size();
+            LogParser::append_batch(&original_db, *batch);
+            histogram.add(batch->logs.data(), batch->logs.size());
+            pattern_counts.resize(original_db.templates.size(), 0);
+            for (const LogParser::LogDetailNew& d : batch->logs) {
+                pattern_counts[d.template_id]++;
+            }
+            patterns_dirty = true;
+            minimap.addRows(original_db);
+            appendFilterRows(first_new_row);
+        }
+
+        if (!running) {
 #ifdef _DEBUG
-    void loadDefaultLogs() {
-        std::vector<std::string> paths;
-        for (int i = 55; i < 57; i++) {
-            char p[1024];
-            sprintf(p, "D:/Projects/log-parser/WV-ST-20240308/WV-ST-20240308-%04d.log", i);
-            std::string path = std::string(p);
-            paths.push_back(path);
+            LogParser::dump_load_stats(import_job->stats, std::cout);
+#endif
+            import_job.reset();
+            view_dirty |= sort_active;
+            minimap.invalidate();
         }
-        std::thread writer(&writerThread, std::ref(load_stats), std::ref(new_db), paths);
-        writer.detach();
     }
-#endif
 
-    static void writerThread(LogParser::LoadFileStats& data, LogParser::LogStats& new_db, std::vector<std::string> paths) {
-        new_db = LogParser::load_files_new(paths, &data);
-    }
-
-    static void resetFilter(Filter& filter) {
-        //std::fill(std::begin(filter.str), std::end(filter.str), 0);
-        //std::fill(std::begin(filter.str_raw), std::end(filter.str_raw), 0);
-        //filter.is_case_sensitive = false;
-        filter.pattern_map.clear();
-        filter.is_regex_error = false;
-    }
-
-    static void parseFilter(Filter* filter) {
-        resetFilter(*filter);
-        std::string sfilter = std::string(filter->str);
-
-        boost::regex_constants::syntax_option_type flag = boost::regex_constants::perl;
-        if (!filter->is_case_sensitive) {
-            flag |= boost::regex_constants::icase;
-        }
-
-        try {
-            size_t col_name_start = 0, col_name_end = 0, cond_start = 0, cond_end = 0;
-            for (size_t i = 0; i < sfilter.size(); i++) {
-                char c = sfilter[i];
-                if (col_name_end < 1) {
-                    for (; i < sfilter.size() && sfilter[i] == ' '; i++);
-                    col_name_start = i;
-                    for (; i + 1 < sfilter.size() && sfilter[i + 1] != ' ' && sfilter[i + 1] != '='; i++);
-                    col_name_end = i + 1;
-                }
-                else if (cond_start < 1) {
-                    if (c == '"') {
-                        i = i + 1;
-                        cond_start = i;
-                        for (; i < sfilter.size() && sfilter[i] != '"'; i++);
-                        cond_end = i;
-                        std::string k = sfilter.substr(col_name_start, col_name_end - col_name_start);
-                        std::string v = "^.*" + sfilter.substr(cond_start, cond_end - cond_start) + ".*$";
-                        auto pattern = boost::regex(v, flag);
-                        filter->pattern_map[k] = pattern;
-                    }
-                }
-                else if (cond_end > 0) {
-                    if (c == 'A' || c == 'a') {
-                        if (i + 2 < sfilter.size()
-                            && (sfilter[i + 1] == 'N' || sfilter[i + 1] == 'n')
-                            && (sfilter[i + 2] == 'D' || sfilter[i + 2] == 'd')) {
-                            i = i + 3;
-                            for (; i + 1 < sfilter.size() && sfilter[i + 1] == ' '; i++);
-                            col_name_start = i + 1;
-                            col_name_end = 0, cond_start = 0, cond_end = 0;
-                        }
-                    }
-                }
-                for (; i + 1 < sfilter.size() && sfilter[i + 1] == ' '; i++);
+    void pollCompareJob() {
+        if (compare_job == nullptr) {
+            return;
+        }
+        const bool running = compare_job->isRunning();
+        for (const auto& batch : compare_job->takeBatches()) {
+            LogParser::append_batch(&compare_db, *batch);
+        }
+        if (!running) {
+            compare_job.reset();
+        }
+    }
+
+    // Copies the selected rows to the clipboard as raw log lines, in view order.
+    void copySelection() {
+        const size_t max_rows = 100000;
+        const std::vector<uint32_t>& rows = viewRows();
+        std::string text;
+        size_t copied = 0;
+        for (const ImGuiSelectionStorage::Range& r : selection.Ranges) {
+            for (ImS64 i = r.Begin; i < r.End && i < (ImS64)rows.size() && copied < max_rows; i++, copied++) {
+                const LogParser::LogDetailNew& d = original_db.logs[rows[i]];
+                text += '[';
+                text += d.prority;
+                text += ' ';
+                text += *d.thread_name;
+                text += ',';
+                text += d.dt;
+                text += "]:";
+                text += d.content;
+                text += '\n';
             }
+        }
+        copy_status.clear();
+        if (copied == max_rows && selection.Size > (ImS64)max_rows) {
+            copy_status = "Copied the first " + std::to_string(max_rows) + " of " + std::to_string(selection.Size) + " selected rows, use Export for more";
+        }
+        ImGui::SetClipboardText(text.c_str());
+    }
 
-            if (filter->pattern_map.size() == 0) {
-                auto pattern = boost::regex("^.*" + sfilter + ".*$", flag);
-                filter->pattern_map["*"] = pattern;
+    // Rebuilds detail_text and its line index when the selected record changes.
+    void updateDetailText() {
+        long id = selected_id;
+        if (id >= (long)original_db.logs.size()) {
+            id = -1;
+        }
+        if (id == detail_id) {
+            return;
+        }
+        detail_id = id;
+        detail_text.clear();
+        detail_line_starts.clear();
+        if (id >= 0) {
+            // Row ids are row indices in original_db
+            const LogParser::LogDetailNew& info = original_db.logs[id];
+            detail_text.reserve(info.file_name->size() + 1 + info.content.size());
+            detail_text += *info.file_name;
+            detail_text += "\n";
+            detail_text += info.content;
+            for (size_t pos = 0; pos != std::string::npos; ) {
+                detail_line_starts.push_back(pos);
+                pos = detail_text.find('\n', pos);
+                pos = pos == std::string::npos ? pos : pos + 1;
             }
         }
-        catch (const boost::regex_error& e) {
-            std::cerr << "Regex error: " << e.what() << '\n';
-            std::cerr << "Error code: " << e.code() << '\n';
-            filter->is_regex_error = true;
+        detail_line_rows.assign(detail_line_starts.size(), 0);
+    }
+
+    void getDetailLine(size_t line, const char** begin, const char** end) const {
+        *begin = detail_text.data() + detail_line_starts[line];
+        *end = detail_text.data() + (line + 1 < detail_line_starts.size() ? detail_line_starts[line + 1] - 1 : detail_text.size());
+    }
+
+    // End of the first line of content, capped to what fits a table cell (without splitting a UTF-8 sequence).
+    static const char* getContentPreviewEnd(const LogParser::LogDetailNew& d) {
+        const size_t max_preview_len = 512;
+        const char* begin = d.content.data();
+        if (d.first_line_len <= max_preview_len) {
+            return begin + d.first_line_len;
+        }
+        const char* end = begin + max_preview_len;
+        while (end > begin && (*end & 0xC0) == 0x80) {
+            end--;
         }
+        return end;
+    }
 
-        filter->is_regex_error = false;
+    // End of the first MaxExpandedLines lines of content, and their count.
+    static const int MaxExpandedLines = 64;
+    static const char* getContentExpandedEnd(const LogParser::LogDetailNew& d, int* line_count) {
+        const char* p = d.content.data();
+        const char* end = p + d.content.size();
+        int lines = 1;
+        while (const char* nl = (const char*)memchr(p, '\n', end - p)) {
+            if (lines == MaxExpandedLines) {
+                end = nl;
+                break;
+            }
+            lines++;
+            p = nl + 1;
+        }
+        if (line_count != nullptr) {
+            *line_count = lines;
+        }
+        return end;
     }
 
-    static bool isLineMatchFilter(const LogParser::LogDetailNew& info, const Filter& filter, boost::smatch& matches) {
-        auto m = filter.pattern_map;
-        boost::regex* regex_default = nullptr;
-        auto default_it = m.find("*");
-        if (default_it != m.end()) {
-            regex_default = &default_it->second;
+    // Brings row_heights up to date with the view: rebuilt after the view or the font changed, otherwise only
+    // the rows appended since the last frame are measured.
+    void updateRowHeights(const std::vector<uint32_t>& rows) {
+        const float line_height = ImGui::GetTextLineHeight();
+        if (row_heights_dirty || row_heights_line_height != line_height || row_heights.Size() > (int)rows.size()) {
+            row_heights_dirty = false;
+            row_heights_line_height = line_height;
+            row_heights.Clear();
+        }
+        const float padding = ImGui::GetStyle().CellPadding.y * 2;
+        for (size_t i = row_heights.Size(); i < rows.size(); i++) {
+            int line_count;
+            getContentExpandedEnd(original_db.logs[rows[i]], &line_count);
+            row_heights.PushBack(line_count * line_height + padding);
         }
+    }
 
-        std::vector <std::pair<std::string, const std::string&>> keys = {
-            {"C1", info.dt},
-            {"C2", info.prority},
-            {"C3", *info.thread_name},
-            {"C4", info.content}
-        };
+    const std::vector<uint32_t>& viewRows() const {
+        return sort_active ? sorted_rows : filter_rows;
+    }
 
-        if (regex_default == nullptr) {
-            for (const auto& kv : keys) {
-                auto it = m.find(kv.first);
-                if (it != m.end()) {
-                    if (!boost::regex_match(kv.second, matches, it->second)) {
-                        return false;
-                    }
-                }
+    // Rebuilds the view for the current filter and pattern.
+    void applyFilter() {
+        filter_rows.clear();
+        filter_bits.clear();
+        selection.Clear();
+        copy_status.clear();
+        selected_pos = -1;
+        bookmarks_dirty = true;
+        row_heights_dirty = true;
+        view_histogram.clear();
+        group_by.clear();
+        resetFindWindow();
+        scroll_to_top = true;
+        appendFilterRows(0);
+    }
+
+    // Tests rows [first_row, end) of original_db against filter and pattern_filter and adds the matches to the view.
+    void appendFilterRows(size_t first_row) {
+        const size_t row_count = original_db.logs.size();
+        filter_bits.resize((row_count + 63) / 64, 0);
+        boost::smatch matches;
+        for (size_t row = first_row; row < row_count; row++) {
+            const LogParser::LogDetailNew& info = original_db.logs[row];
+            if (pattern_filter >= 0 && info.template_id != pattern_filter) {
+                continue;
+            }
+            if (LogParser::isLineMatchFilter(info, filter, matches)) {
+                filter_rows.push_back((uint32_t)row);
+                filter_bits[row / 64] |= (uint64_t)1 << (row % 64);
+                view_histogram.add(info.ts, info.level);
             }
-            return true;
         }
-        else {
-            for (const auto& kv : keys) {
-                if (boost::regex_match(kv.second, matches, *regex_default)) {
-                    return true;
+        // While an import grows the view, only re-sort it and redo the minimap when it grew by 1/16th: every
+        // rebuild walks the whole view, doing it per batch would be quadratic. pollImportJob() catches up at the end.
+        const bool importing = first_row != 0 && import_job != nullptr && import_job->isRunning();
+        if (!importing || filter_rows.size() >= sorted_rows.size() * 17 / 16) {
+            view_dirty |= sort_active;
+        }
+        if (!importing || filter_rows.size() >= minimap.viewSize() * 17 / 16) {
+            minimap.invalidate();
+        }
+    }
+
+    // Composes the cached permutation for the sort key with the filter bitmap. The selection follows its rows
+    // to their new view positions.
+    void rebuildSortedView() {
+        view_dirty = false;
+        // sorted_rows is only empty when the selection was made on filter_rows (or when there is nothing to select)
+        std::vector<uint64_t> selected_bits;
+        getSelectedRows(sorted_rows.empty() ? filter_rows : sorted_rows, &selected_bits);
+        sorted_rows.clear();
+        bookmarks_dirty = true;
+        row_heights_dirty = true;
+        minimap.invalidate();
+        if (sort_active) {
+            const std::vector<uint32_t>& perm = sort_index.get(original_db, sort_key);
+            const bool all_rows = filter_rows.size() == perm.size();
+            sorted_rows.reserve(filter_rows.size());
+            for (size_t i = 0; i < perm.size(); i++) {
+                const uint32_t row = sort_descending ? perm[perm.size() - 1 - i] : perm[i];
+                if (all_rows || (filter_bits[row / 64] >> (row % 64)) & 1) {
+                    sorted_rows.push_back(row);
                 }
             }
-            return false;
         }
+        setSelectedRows(viewRows(), selected_bits);
     }
 
+    // The rows at the selected positions of the view rows, as a bitmap over original_db rows. Left empty when
+    // nothing is selected.
+    void getSelectedRows(const std::vector<uint32_t>& rows, std::vector<uint64_t>* out_bits) const {
+        out_bits->clear();
+        if (selection.Size == 0) {
+            return;
+        }
+        out_bits->resize((original_db.logs.size() + 63) / 64, 0);
+        for (const ImGuiSelectionStorage::Range& r : selection.Ranges) {
+            for (ImS64 i = r.Begin; i < r.End && i < (ImS64)rows.size(); i++) {
+                (*out_bits)[rows[i] / 64] |= (uint64_t)1 << (rows[i] % 64);
+            }
+        }
+    }
+
+    // Selects the positions of rows found in bits, built by getSelectedRows(), and finds selected_id again.
+    // Runs of selected positions are appended as ranges directly, the view is walked in order.
+    void setSelectedRows(const std::vector<uint32_t>& rows, const std::vector<uint64_t>& bits) {
+        selection.Clear();
+        selected_pos = -1;
+        for (size_t i = 0; i < rows.size(); i++) {
+            const uint32_t row = rows[i];
+            if ((long)row == selected_id) {
+                selected_pos = (int64_t)i;
+            }
+            if (bits.empty() || !((bits[row / 64] >> (row % 64)) & 1)) {
+                continue;
+            }
+            if (selection.Ranges.Size > 0 && selection.Ranges.back().End == (ImS64)i) {
+                selection.Ranges.back().End++;
+            }
+            else {
+                ImGuiSelectionStorage::Range range = { (ImS64)i, (ImS64)i + 1 };
+                selection.Ranges.push_back(range);
+            }
+            selection.Size++;
+        }
+    }
+
+    void rebuildPatternRows() {
+        patterns_dirty = false;
+        pattern_rows.resize(pattern_counts.size());
+        for (size_t i = 0; i < pattern_rows.size(); i++) {
+            pattern_rows[i] = (uint32_t)i;
+        }
+        std::stable_sort(pattern_rows.begin(), pattern_rows.end(), [this](uint32_t a, uint32_t b) {
+            if (pattern_sort_descending) {
+                std::swap(a, b);
+            }
+            if (pattern_sort_by_text) {
+                return original_db.templates[a] < original_db.templates[b];
+            }
+            return pattern_counts[a] < pattern_counts[b];
+        });
+    }
+
+    void rebuildGroupRows() {
+        groups_dirty = false;
+        const std::vector<LogParser::GroupBy::Group>& groups = group_by.getGroups();
+        group_rows.clear();
+        for (size_t i = 0; i < groups.size(); i++) {
+            if (groups[i].count > 0) {
+                group_rows.push_back((uint32_t)i);
+            }
+        }
+        std::vector<std::string> labels;
+        if (group_sort_column == 0) {
+            labels.resize(groups.size());
+            for (uint32_t i : group_rows) {
+                labels[i] = group_by.getLabel(original_db, i);
+            }
+        }
+        std::stable_sort(group_rows.begin(), group_rows.end(), [&](uint32_t a, uint32_t b) {
+            if (group_sort_descending) {
+                std::swap(a, b);
+            }
+            switch (group_sort_column) {
+            case 0: return labels[a] < labels[b];
+            case 2: return groups[a].level_counts[LogParser::LogLevel_Err] < groups[b].level_counts[LogParser::LogLevel_Err];
+            case 3: return groups[a].level_counts[LogParser::LogLevel_Wrn] < groups[b].level_counts[LogParser::LogLevel_Wrn];
+            case 4: return groups[a].first_ts < groups[b].first_ts;
+            case 5: return groups[a].last_ts < groups[b].last_ts;
+            default: return groups[a].count < groups[b].count;
+            }
+        });
+    }
+
+    // Sorts the rows of every diff tab on the current sort column. Share and peak sort on their magnitude.
+    void rebuildDiffRows(const LogParser::LogDiff& diff) {
+        diff_dirty = false;
+        for (int k = 0; k < LogParser::DiffKey_COUNT; k++) {
+            const std::vector<LogParser::DiffRow>& src = diff.rows[k];
+            std::vector<uint32_t>& rows = diff_rows[k];
+            rows.resize(src.size());
+            for (size_t i = 0; i < rows.size(); i++) {
+                rows[i] = (uint32_t)i;
+            }
+            std::stable_sort(rows.begin(), rows.end(), [&](uint32_t a, uint32_t b) {
+                if (diff_sort_descending) {
+                    std::swap(a, b);
+                }
+                const LogParser::DiffRow& ra = src[a];
+                const LogParser::DiffRow& rb = src[b];
+                switch (diff_sort_column) {
+                case 0: return ra.label < rb.label;
+                case 1: return ra.count[0] < rb.count[0];
+                case 2: return ra.count[1] < rb.count[1];
+                case 4: return ra.first_offset_ms[0] < rb.first_offset_ms[0];
+                case 5: return ra.first_offset_ms[1] < rb.first_offset_ms[1];
+                case 6: return std::abs(ra.peak_delta) < std::abs(rb.peak_delta);
+                default: return std::abs(getDiffShareChange(diff, ra)) < std::abs(getDiffShareChange(diff, rb));
+                }
+            });
+        }
+    }
+
+    void resetLogWindow() {
+        original_db = {};
+        filter_rows.clear();
+        filter_bits.clear();
+        sorted_rows.clear();
+        sort_index.clear();
+        view_dirty = true;
+        histogram.clear();
+        view_histogram.clear();
+        timeline_begin = timeline_end = 0;
+        pattern_counts.clear();
+        pattern_rows.clear();
+        pattern_filter = -1;
+        group_by.clear();
+        group_rows.clear();
+        selection.Clear();
+        copy_status.clear();
+        selected_id = -1;
+        selected_pos = -1;
+        bookmarks.clear();
+        bookmark_positions.clear();
+        minimap.clear();
+        detail_id = -1;
+        detail_text.clear();
+        detail_line_starts.clear();
+        detail_line_rows.clear();
+        resetFindWindow();
+    }
+
+    void resetFindWindow() {
+        scroll_to_id = -1;
+        scrolled = true;
+    }
+
+#ifdef _DEBUG
+    void loadDefaultLogs() {
+        std::vector<std::string> paths;
+        for (int i = 55; i < 57; i++) {
+            char p[1024];
+            sprintf(p, "D:/Projects/log-parser/WV-ST-20240308/WV-ST-20240308-%04d.log", i);
+            std::string path = std::string(p);
+            paths.push_back(path);
+        }
+        startImport(paths);
+    }
+#endif
+
     // Temporary c_str case insensitive equality test
     // https://stackoverflow.com/questions/27303062/strstr-function-like-that-ignores-upper-or-lower-case
     static char* stristr(const char* haystack, const char* needle) {
@@ -128,6 +128,9 @@ int WinMain(
     //ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf", 18.0f, nullptr, io.Fonts->GetGlyphRangesJapanese());
     //IM_ASSERT(font != nullptr);
 
+    // The log table draws the same short texts (levels, thread names, timestamps) every frame
+    io.Fonts->Flags |= ImFontAtlasFlags_TextRunCache;
+
     // Our state
     bool show_demo_window = true;
     bool show_another_window = false;
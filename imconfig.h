@@ -48,6 +48,8 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_ENABLE_SSE4_2_CRC                           // Use SSE 4.2 CRC32 instructions in ImHashData()/ImHashStr() (requires compiling with SSE 4.2). IDs change, including those stored in .ini files.
+//#define IMGUI_STORAGE_OPEN_ADDRESSING                     // Index ImGuiStorage with an open-addressing hash table instead of keeping it sorted: O(1) insertions instead of O(N), for very large storages (e.g. tens of thousands of open tree nodes).
 
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 // May be convenient for some users to only explicitly include vanilla imgui.h and have extra stuff included.
@@ -122,6 +124,13 @@
 //---- Debug Tools: Enable slower asserts
 //#define IMGUI_DEBUG_PARANOID
 
+//---- Debug Tools: Account memory allocations to the subsystem that made them (Metrics->Memory allocations, ImGui::DebugGetMemTagStats()).
+// Adds a 16 bytes header to every allocation: memory passed to MemFree() must come from MemAlloc().
+//#define IMGUI_DEBUG_MEM_TAGS
+
+//---- Debug Tools: Enable the frame profiler (Metrics->Profiler). Otherwise ProfilerPushScope()/ProfilerPopScope() are empty and nothing is timed.
+//#define IMGUI_ENABLE_PROFILER
+
 //---- Tip: You can add extra functions within the ImGui:: namespace from anywhere (e.g. your own sources/header files)
 /*
 namespace ImGui
@@ -32,6 +32,7 @@
 #define IMGUI_HAS_TABLE
 #define IMGUI_HAS_VIEWPORT          // Viewport WIP branch
 #define IMGUI_HAS_DOCK              // Docking WIP branch
+#define IMGUI_HAS_MULTI_SELECT      // Multi-select API (BeginMultiSelect/EndMultiSelect)
 
 /*
 
@@ -46,6 +47,7 @@ Index of this file:
 // [SECTION] ImGuiIO
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiWindowClass, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
+// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiSelectionRequest, ImGuiMultiSelectIO, ImGuiSelectionStorage)
 // [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
@@ -157,17 +159,22 @@ struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_t
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
+struct ImFontTextRunCache;          // Glyph quads of texts recently drawn by ImFont::RenderText() (ImFontAtlasFlags_TextRunCache)
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper to store the heights of variable height items for ImGuiListClipper, with O(log N) position<->index lookups
+struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiPlatformIO;             // Multi-viewport support: interface for Platform/Renderer backends + viewports to render
 struct ImGuiPlatformMonitor;        // Multi-viewport support: user-provided bounds for each connected monitor/display. Used when positioning popups and tooltips to avoid them straddling monitors
 struct ImGuiPlatformImeData;        // Platform IME data for io.SetPlatformImeDataFn() function.
+struct ImGuiSelectionRequest;       // A selection request (stored in ImGuiMultiSelectIO)
+struct ImGuiSelectionStorage;       // Helper to store multi-selection state + apply multi-selection requests, as sorted ranges of indices
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
 struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
@@ -216,6 +223,7 @@ typedef int ImGuiFocusedFlags;      // -> enum ImGuiFocusedFlags_    // Flags: f
 typedef int ImGuiHoveredFlags;      // -> enum ImGuiHoveredFlags_    // Flags: for IsItemHovered(), IsWindowHovered() etc.
 typedef int ImGuiInputTextFlags;    // -> enum ImGuiInputTextFlags_  // Flags: for InputText(), InputTextMultiline()
 typedef int ImGuiKeyChord;          // -> ImGuiKey | ImGuiMod_XXX    // Flags: for IsKeyChordPressed(), Shortcut() etc. an ImGuiKey optionally OR-ed with one or more ImGuiMod_XXX values.
+typedef int ImGuiMultiSelectFlags;  // -> enum ImGuiMultiSelectFlags_// Flags: for BeginMultiSelect()
 typedef int ImGuiPopupFlags;        // -> enum ImGuiPopupFlags_      // Flags: for OpenPopup*(), BeginPopupContext*(), IsPopupOpen()
 typedef int ImGuiSelectableFlags;   // -> enum ImGuiSelectableFlags_ // Flags: for Selectable()
 typedef int ImGuiSliderFlags;       // -> enum ImGuiSliderFlags_     // Flags: for DragFloat(), DragInt(), SliderFloat(), SliderInt() etc.
@@ -253,6 +261,10 @@ typedef unsigned int        ImU32;  // 32-bit unsigned integer (often used to st
 typedef signed   long long  ImS64;  // 64-bit signed integer
 typedef unsigned long long  ImU64;  // 64-bit unsigned integer
 
+// Multi-Selection item index or identifier when using SetNextItemSelectionUserData()/BeginMultiSelect()
+// (Most users are likely to use this store an item INDEX but this may be used to store a POINTER as well.)
+typedef ImS64 ImGuiSelectionUserData;
+
 // Character types
 // (we generally use UTF-8 encoded string in the API. This is storage specifically for a decoded character used for keyboard input and display)
 typedef unsigned int ImWchar32;     // A single decoded U32 character/code point. We encode them as multi bytes UTF-8 when used in strings.
@@ -432,6 +444,17 @@ namespace ImGui
     IMGUI_API void          SetScrollFromPosX(float local_x, float center_x_ratio = 0.5f);  // adjust scrolling amount to make given position visible. Generally GetCursorStartPos() + offset to compute a valid position.
     IMGUI_API void          SetScrollFromPosY(float local_y, float center_y_ratio = 0.5f);  // adjust scrolling amount to make given position visible. Generally GetCursorStartPos() + offset to compute a valid position.
 
+    // Large scrolling (child windows created with ImGuiChildFlags_LargeScrollY)
+    // - float positions lose precision past a few million pixels: a list of 20M items of 17 pixels can't be scrolled through reliably.
+    // - In large scrolling windows the logical scroll position is stored in double, and float positions are relative to a base which
+    //   follows the scroll position. GetScrollY(), GetCursorPos() etc. return positions relative to that base.
+    // - ImGuiListClipper places its items at their logical position and submits its logical height to the window, so clippers can address all their items.
+    //   Other contents must be submitted before the clipper. They are laid out as usual and scroll out of view with the first items.
+    // - In other windows these functions are equivalent to GetScrollY()/GetScrollMaxY()/SetScrollY().
+    IMGUI_API double        GetLargeScrollY();                                              // get logical scrolling amount [0 .. GetLargeScrollMaxY()]
+    IMGUI_API double        GetLargeScrollMaxY();                                           // get maximum logical scrolling amount
+    IMGUI_API void          SetLargeScrollY(double scroll_y);                               // set logical scrolling amount [0 .. GetLargeScrollMaxY()]
+
     // Parameters stacks (shared)
     IMGUI_API void          PushFont(ImFont* font);                                         // use NULL as a shortcut to push default font
     IMGUI_API void          PopFont();
@@ -665,6 +688,16 @@ namespace ImGui
     IMGUI_API bool          Selectable(const char* label, bool selected = false, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0)); // "bool selected" carry the selection state (read-only). Selectable() is clicked is returns true so you can modify your selection state. size.x==0.0: use remaining width, size.x>0.0: specify width. size.y==0.0: use label height, size.y>0.0: specify height
     IMGUI_API bool          Selectable(const char* label, bool* p_selected, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0));      // "bool* p_selected" point to the selection state (read-write), as a convenient helper.
 
+    // Multi-selection system for Selectable()
+    // - Wrap your items between BeginMultiSelect()/EndMultiSelect() and call SetNextItemSelectionUserData() with the item index before each Selectable().
+    // - Clicks, Ctrl+Click, Shift+Click, Shift+Arrows and Ctrl+A are turned into a list of requests (select all / clear all / set range) which you apply to your selection storage.
+    // - Ranges are expressed in item indices, so they may span items that were never submitted: this works with ImGuiListClipper.
+    // - ImGuiSelectionStorage is a ready-to-use storage for those requests. See the multi-select section further down this file.
+    IMGUI_API ImGuiMultiSelectIO*   BeginMultiSelect(ImGuiMultiSelectFlags flags, int items_count = -1);
+    IMGUI_API ImGuiMultiSelectIO*   EndMultiSelect();
+    IMGUI_API void                  SetNextItemSelectionUserData(ImGuiSelectionUserData selection_user_data);
+    IMGUI_API bool                  IsItemToggledSelection();                                   // Was the last item selection toggled? (after Selectable(), TreeNode() etc. We only returns toggle _event_ in order to handle clipping correctly)
+
     // Widgets: List Boxes
     // - This is essentially a thin wrapper to using BeginChild/EndChild with the ImGuiChildFlags_FrameStyle flag for stylistic changes + displaying a label.
     // - You can submit contents and manage your selection state however you want it, by creating e.g. Selectable() or any other items.
@@ -1008,6 +1041,14 @@ namespace ImGui
     IMGUI_API void          DebugStartItemPicker();
     IMGUI_API bool          DebugCheckVersionAndDataLayout(const char* version_str, size_t sz_io, size_t sz_style, size_t sz_vec2, size_t sz_vec4, size_t sz_drawvert, size_t sz_drawidx); // This is called by IMGUI_CHECKVERSION() macro.
 
+    // Profiler
+    // - NewFrame(), EndFrame(), Render(), table layout and some backends are timed, and shown as a timeline in Metrics->Profiler.
+    // - Time your own code with ProfilerPushScope()/ProfilerPopScope() to compare. 'name' is not copied: pass a literal or a string that outlives the recorded scopes.
+    // - Only compiled in with IMGUI_ENABLE_PROFILER in imconfig.h, otherwise those functions are empty.
+    IMGUI_API void          ProfilerPushScope(const char* name);
+    IMGUI_API void          ProfilerPopScope();
+    IMGUI_API bool          ProfilerSaveChromeTraceToDisk(const char* filename);                // write the recorded scopes as Chrome trace event JSON (open in chrome://tracing or ui.perfetto.dev). return false on failure.
+
     // Memory Allocators
     // - Those functions are not reliant on the current context.
     // - DLL users: heaps and globals are not shared across DLL boundaries! You will need to call SetCurrentContext() + SetAllocatorFunctions()
@@ -1016,6 +1057,7 @@ namespace ImGui
     IMGUI_API void          GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeFunc* p_free_func, void** p_user_data);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API void*         MemAllocFrame(size_t size);                         // Scratch memory valid until the next NewFrame(), from a per-frame linear allocator: don't MemFree() it. Requires a current context. A repeating frame doesn't call MemAlloc() for sizes up to 32 KB.
 
     // (Optional) Platform/OS interface for multi-viewport support
     // Read comments around the ImGuiPlatformIO structure for more details.
@@ -1097,6 +1139,7 @@ enum ImGuiChildFlags_
     ImGuiChildFlags_AutoResizeY             = 1 << 5,   // Enable auto-resizing height. Read "IMPORTANT: Size measurement" details above.
     ImGuiChildFlags_AlwaysAutoResize        = 1 << 6,   // Combined with AutoResizeX/AutoResizeY. Always measure size even when child is hidden, always return true, always disable clipping optimization! NOT RECOMMENDED.
     ImGuiChildFlags_FrameStyle              = 1 << 7,   // Style the child window like a framed item: use FrameBg, FrameRounding, FrameBorderSize, FramePadding instead of ChildBg, ChildRounding, ChildBorderSize, WindowPadding.
+    ImGuiChildFlags_LargeScrollY            = 1 << 8,   // Keep the vertical scroll position in double precision, for contents taller than float can address (e.g. a ImGuiListClipper over tens of millions of items). Read "Large scrolling" details above GetLargeScrollY().
 };
 
 // Flags for ImGui::InputText()
@@ -1197,6 +1240,17 @@ enum ImGuiSelectableFlags_
 #endif
 };
 
+// Flags for ImGui::BeginMultiSelect()
+enum ImGuiMultiSelectFlags_
+{
+    ImGuiMultiSelectFlags_None              = 0,
+    ImGuiMultiSelectFlags_SingleSelect      = 1 << 0,   // Disable selecting more than one item. Ctrl+Click and Shift+Click behave like a plain click.
+    ImGuiMultiSelectFlags_NoSelectAll       = 1 << 1,   // Disable Ctrl+A shortcut to select all.
+    ImGuiMultiSelectFlags_NoRangeSelect     = 1 << 2,   // Disable Shift+Click and Shift+Arrows range selection.
+    ImGuiMultiSelectFlags_ClearOnEscape     = 1 << 3,   // Clear selection when pressing Escape while the scope is focused.
+    ImGuiMultiSelectFlags_ClearOnClickVoid  = 1 << 4,   // Clear selection when clicking on empty space within the scope's window.
+};
+
 // Flags for ImGui::BeginCombo()
 enum ImGuiComboFlags_
 {
@@ -2539,13 +2593,28 @@ struct ImGuiStorage
         ImGuiStoragePair(ImGuiID _key, float _val)  { key = _key; val_f = _val; }
         ImGuiStoragePair(ImGuiID _key, void* _val)  { key = _key; val_p = _val; }
     };
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    struct ImGuiStorageSlot
+    {
+        ImGuiID key;
+        int     index;                      // Index into Data, -1 for an empty slot
+    };
+#endif
 
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    ImVector<ImGuiStorageSlot>      Slots;  // Hash table over Data: linear probing, power-of-two size, at most half full
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+    // - With IMGUI_STORAGE_OPEN_ADDRESSING, pairs are kept in insertion order and indexed by a hash table instead: queries and insertions are O(1).
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    void                Clear() { Data.clear(); Slots.clear(); }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2565,11 +2634,42 @@ struct ImGuiStorage
     IMGUI_API void**    GetVoidPtrRef(ImGuiID key, void* default_val = NULL);
 
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // With IMGUI_STORAGE_OPEN_ADDRESSING this also rebuilds the hash table, which is required after adding to Data directly.
     IMGUI_API void      BuildSortByKey();
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 };
 
+// Helper: Heights of variable height items, for ImGuiListClipper::Begin(ImGuiListClipperHeights*).
+// Heights are indexed by a Fenwick tree of their sums, so finding the item at a given position, the position of
+// a given item, and changing the height of one item (e.g. when a row is expanded) are all O(log N).
+// A height includes the spacing to the next item, e.g. GetTextLineHeightWithSpacing() for one line of text.
+// Usage:
+//   static ImGuiListClipperHeights heights;
+//   heights.Resize(items_count, ImGui::GetTextLineHeightWithSpacing()); // Keeps the heights of existing items
+//   ImGuiListClipper clipper;
+//   clipper.Begin(&heights);
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           ImGui::TextUnformatted(items[i]);                             // Multi-line items, see heights.SetHeight()
+struct ImGuiListClipperHeights
+{
+    ImVector<float>     Heights;        // Height of each item
+    ImVector<double>    Sums;           // Fenwick tree, 1-based: Sums[i] = sum of Heights[i - (i & -i)] to Heights[i - 1]
+
+    void                Clear()                     { Heights.clear(); Sums.clear(); }
+    int                 Size() const                { return Heights.Size; }
+    float               GetHeight(int idx) const    { IM_ASSERT(idx >= 0 && idx < Heights.Size); return Heights[idx]; }
+    double              GetTotalHeight() const      { return GetPosition(Heights.Size); }
+    IMGUI_API void      Build(const float* heights, int items_count);                                     // O(N)
+    IMGUI_API void      Build(int items_count, float (*getter)(void* user_data, int idx), void* user_data); // O(N), heights from a callback
+    IMGUI_API void      Resize(int items_count, float new_items_height);    // Keep existing heights, O(K log N) to add K items
+    IMGUI_API void      PushBack(float height);                             // O(log N)
+    IMGUI_API void      SetHeight(int idx, float height);                   // O(log N)
+    IMGUI_API double    GetPosition(int idx) const;                         // Sum of the heights of items before idx, O(log N)
+    IMGUI_API int       GetIndexAtPosition(double pos) const;               // Item covering pos, clamped to [0, Size() - 1], O(log N)
+};
+
 // Helper: Manually clip large list of items.
 // If you have lots evenly spaced items and you have random access to the list, you can perform coarse
 // clipping based on visibility to only submit items that are in view.
@@ -2590,21 +2690,25 @@ struct ImGuiStorage
 // - Clipper calculate the actual range of elements to display based on the current clipping rectangle, position the cursor before the first visible element.
 // - User code submit visible elements.
 // - The clipper also handles various subtleties related to keyboard/gamepad navigation, wrapping etc.
+// Items of different heights can be clipped too, by passing their heights in a ImGuiListClipperHeights to Begin().
 struct ImGuiListClipper
 {
     ImGuiContext*   Ctx;                // Parent UI context
     int             DisplayStart;       // First item to display, updated by each call to Step()
     int             DisplayEnd;         // End of items to display (exclusive)
     int             ItemsCount;         // [Internal] Number of items
-    float           ItemsHeight;        // [Internal] Height of item after a first step and item submission can calculate it
+    float           ItemsHeight;        // [Internal] Height of item after a first step and item submission can calculate it (average height of variable height items)
     float           StartPosY;          // [Internal] Cursor position at the time of Begin() or after table frozen rows are all processed
     void*           TempData;           // [Internal] Internal data
+    ImGuiListClipperHeights* ItemsHeights; // [Internal] Heights of variable height items, or NULL
 
     // items_count: Use INT_MAX if you don't know how many items you have (in which case the cursor won't be advanced in the final step)
     // items_height: Use -1.0f to be calculated automatically on first step. Otherwise pass in the distance between your items, typically GetTextLineHeightWithSpacing() or GetFrameHeightWithSpacing().
+    // items_heights: Variable height items. Its Size() is the number of items. It must stay valid and unchanged until End().
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
     IMGUI_API void  Begin(int items_count, float items_height = -1.0f);
+    IMGUI_API void  Begin(ImGuiListClipperHeights* items_heights);
     IMGUI_API void  End();             // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool  Step();            // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
@@ -2693,6 +2797,71 @@ struct ImColor
     static ImColor HSV(float h, float s, float v, float a = 1.0f)   { float r, g, b; ImGui::ColorConvertHSVtoRGB(h, s, v, r, g, b); return ImColor(r, g, b, a); }
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiSelectionRequest, ImGuiMultiSelectIO, ImGuiSelectionStorage)
+//-----------------------------------------------------------------------------
+// Usage, with item indices as selection user data:
+//   ImGuiSelectionStorage selection;
+//   ImGuiMultiSelectIO* ms_io = ImGui::BeginMultiSelect(ImGuiMultiSelectFlags_ClearOnEscape, items_count);
+//   selection.ApplyRequests(ms_io);
+//   ImGuiListClipper clipper;
+//   clipper.Begin(items_count);
+//   while (clipper.Step())
+//       for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+//       {
+//           ImGui::SetNextItemSelectionUserData(n);
+//           ImGui::Selectable(label, selection.Contains(n));
+//       }
+//   ms_io = ImGui::EndMultiSelect();
+//   selection.ApplyRequests(ms_io);
+// Requests only carry indices: a Shift+Click across a million rows is a single SetRange request,
+// and Ctrl+A is a single SetAll request. Applying them costs O(ranges) with ImGuiSelectionStorage.
+//-----------------------------------------------------------------------------
+
+enum ImGuiSelectionRequestType
+{
+    ImGuiSelectionRequestType_None = 0,
+    ImGuiSelectionRequestType_SetAll,           // Request app to clear selection (if Selected==false) or select all items (if Selected==true)
+    ImGuiSelectionRequestType_SetRange,         // Request app to select/unselect [RangeFirstItem..RangeLastItem] items (inclusive) based on value of Selected. Only EndMultiSelect() requests this.
+};
+
+// Selection request item
+struct ImGuiSelectionRequest
+{
+    ImGuiSelectionRequestType   Type;           // Request type. You'll most often receive 1 Clear + 1 SetRange with a single-item range.
+    bool                        Selected;       // Parameter for SetAll/SetRange requests (true = select, false = unselect)
+    ImGuiSelectionUserData      RangeFirstItem; // Parameter for SetRange request (this is generally == RangeSrcItem when shift selecting from top to bottom). Always <= RangeLastItem.
+    ImGuiSelectionUserData      RangeLastItem;  // Parameter for SetRange request (this is generally == RangeSrcItem when shift selecting from bottom to top). Always >= RangeFirstItem.
+};
+
+// Main IO structure returned by BeginMultiSelect()/EndMultiSelect().
+// Requests are to be applied in order. A SetAll request always comes first (earlier requests are dropped when one is emitted).
+struct ImGuiMultiSelectIO
+{
+    ImVector<ImGuiSelectionRequest> Requests;   //  ms:w, app:r     /  ms:w  app:r   // Requests to apply to your selection data.
+    ImGuiSelectionUserData      RangeSrcItem;   //  ms:w  app:r     /                // Anchor of Shift+Click/Shift+Arrows ranges: last item clicked or Ctrl+Clicked.
+    ImGuiSelectionUserData      NavIdItem;      //  ms:w, app:r     /                // (If using clipper) Item which has keyboard focus, or was last clicked.
+    int                         ItemsCount;     //  ms:w, app:r     /        app:r   // 'int items_count' parameter to BeginMultiSelect() is copied here for convenience. Used by SetAll requests.
+};
+
+// Helper storage for multi-selection, using sorted and disjoint ranges of indices.
+// - Contains() is O(log ranges), SetRange() is O(ranges) at worst, select all is O(1).
+// - Only works with indices as selection user data (what you pass to SetNextItemSelectionUserData()).
+// - Iterate the selection with 'for (const ImGuiSelectionStorage::Range& r : selection.Ranges)', r.Begin..r.End (exclusive).
+struct ImGuiSelectionStorage
+{
+    struct Range { ImS64 Begin, End; };
+    ImVector<Range>     Ranges;         // Sorted, disjoint and non-adjacent ranges
+    ImS64               Size;           // Number of selected items
+
+    ImGuiSelectionStorage()             { Size = 0; }
+    void                Clear()         { Ranges.resize(0); Size = 0; }
+    IMGUI_API bool      Contains(ImS64 idx) const;
+    IMGUI_API void      SetRange(ImS64 first, ImS64 last, bool selected);   // [first..last] inclusive
+    void                SetItemSelected(ImS64 idx, bool selected) { SetRange(idx, idx, selected); }
+    IMGUI_API void      ApplyRequests(ImGuiMultiSelectIO* ms_io);
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -3070,6 +3239,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_TextRunCache       = 1 << 3,   // Cache the glyph quads of short single-line texts drawn again and again (labels, table cells), so RenderText() translates and copies them instead of decoding the text and looking up each glyph. Not thread-safe: RenderText() writes to the cache, so don't render with the atlas fonts from several threads at once (e.g. contexts sharing an atlas).
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3215,9 +3385,11 @@ struct ImFont
     float                       EllipsisWidth;      // 4     // out               // Width
     float                       EllipsisCharStep;   // 4     // out               // Step between characters when EllipsisCount > 0
     bool                        DirtyLookupTables;  // 1     // out //
+    bool                        AsciiAdvanceXIntegral; // 1  // out //            // All ASCII characters advance by whole pixels, so CalcTextSize functions can add up their widths in any order
     float                       Scale;              // 4     // in  // = 1.f      // Base font scale, multiplied by the per-window font scale which you can adjust with SetWindowFontScale()
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    ImFontTextRunCache*         TextRunCache;       // 4-8   // out //            // Glyph quads of texts recently drawn by RenderText(), when built with ImFontAtlasFlags_TextRunCache. Written by const RenderText(): not thread-safe
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
     // Methods
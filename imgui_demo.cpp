@@ -1426,6 +1426,35 @@ static void ShowDemoWindowWidgets()
             }
             ImGui::TreePop();
         }
+        IMGUI_DEMO_MARKER("Widgets/Selectables/Multi-Select with Clipper");
+        if (ImGui::TreeNode("Selection State: Multi-Select with Clipper"))
+        {
+            HelpMarker("BeginMultiSelect() turns Click, Ctrl+Click, Shift+Click, Shift+Arrows and Ctrl+A into range requests.\nRanges may cover clipped items.");
+            const int ITEMS_COUNT = 100000;
+            static ImGuiSelectionStorage selection;
+            ImGui::Text("Selection: %d items in %d ranges", (int)selection.Size, selection.Ranges.Size);
+            if (ImGui::BeginListBox("##Basket", ImVec2(-FLT_MIN, ImGui::GetFontSize() * 20)))
+            {
+                ImGuiMultiSelectIO* ms_io = ImGui::BeginMultiSelect(ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_ClearOnClickVoid, ITEMS_COUNT);
+                selection.ApplyRequests(ms_io);
+                ImGuiListClipper clipper;
+                clipper.Begin(ITEMS_COUNT);
+                while (clipper.Step())
+                {
+                    for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                    {
+                        char label[64];
+                        sprintf(label, "Object %05d", n);
+                        ImGui::SetNextItemSelectionUserData(n);
+                        ImGui::Selectable(label, selection.Contains(n));
+                    }
+                }
+                ms_io = ImGui::EndMultiSelect();
+                selection.ApplyRequests(ms_io);
+                ImGui::EndListBox();
+            }
+            ImGui::TreePop();
+        }
         IMGUI_DEMO_MARKER("Widgets/Selectables/Rendering more items on the same line");
         if (ImGui::TreeNode("Rendering more items on the same line"))
         {
@@ -3462,6 +3491,36 @@ static void ShowDemoWindowLayout()
         }
         ImGui::Spacing();
 
+        // Large Scrolling Demo
+        IMGUI_DEMO_MARKER("Layout/Scrolling/Large");
+        HelpMarker(
+            "Child windows created with ImGuiChildFlags_LargeScrollY keep their scroll position in double precision.\n\n"
+            "Here a clipper addresses 1 billion items: without the flag, float positions can't reach most of them.");
+        static bool large_scroll = true;
+        static int large_scroll_goto = 500000000;
+        ImGui::Checkbox("ImGuiChildFlags_LargeScrollY", &large_scroll);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        bool large_scroll_do_goto = ImGui::DragInt("##goto", &large_scroll_goto, 1000000.0f, 0, 999999999);
+        ImGui::SameLine();
+        large_scroll_do_goto |= ImGui::Button("Go to item");
+        {
+            const int ITEMS_COUNT = 1000000000;
+            ImGui::BeginChild("large_scroll", ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 8), ImGuiChildFlags_Border | (large_scroll ? ImGuiChildFlags_LargeScrollY : 0));
+            if (large_scroll_do_goto)
+                ImGui::SetLargeScrollY((double)large_scroll_goto * ImGui::GetTextLineHeightWithSpacing());
+            ImGuiListClipper clipper;
+            clipper.Begin(ITEMS_COUNT, ImGui::GetTextLineHeightWithSpacing());
+            while (clipper.Step())
+                for (int item_n = clipper.DisplayStart; item_n < clipper.DisplayEnd; item_n++)
+                    ImGui::Text("Item %d", item_n);
+            double scroll_y = ImGui::GetLargeScrollY();
+            double scroll_max_y = ImGui::GetLargeScrollMaxY();
+            ImGui::EndChild();
+            ImGui::Text("%.0f/%.0f", scroll_y, scroll_max_y);
+        }
+        ImGui::Spacing();
+
         static bool show_horizontal_contents_size_demo_window = false;
         ImGui::Checkbox("Show Horizontal contents size demo window", &show_horizontal_contents_size_demo_window);
 
@@ -4739,6 +4798,66 @@ static void ShowDemoWindowTables()
         ImGui::TreePop();
     }
 
+    if (open_action != -1)
+        ImGui::SetNextItemOpen(open_action != 0);
+    IMGUI_DEMO_MARKER("Tables/Vertical scrolling, with variable height clipping");
+    if (ImGui::TreeNode("Vertical scrolling, with variable height clipping"))
+    {
+        HelpMarker(
+            "ImGuiListClipper can also clip items of different heights, stored in a ImGuiListClipperHeights.\n\n"
+            "Here every 5th row has 3 lines of text, and clicking a row expands it to 5 lines. Changing the height of a row is O(log N).");
+        static ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+        static ImGuiListClipperHeights heights;
+        static ImVector<int> lines_count;
+        const int ITEMS_COUNT = 100000;
+        const float ROW_PADDING_Y = ImGui::GetStyle().CellPadding.y * 2.0f - ImGui::GetStyle().ItemSpacing.y; // Row height is lines * TEXT_BASE_HEIGHT + ROW_PADDING_Y
+        if (lines_count.Size != ITEMS_COUNT)
+        {
+            lines_count.resize(ITEMS_COUNT);
+            for (int n = 0; n < ITEMS_COUNT; n++)
+                lines_count[n] = (n % 5 == 0) ? 3 : 1;
+        }
+        if (heights.Size() != ITEMS_COUNT)
+        {
+            // Row heights are the height of their lines of text plus cell padding
+            heights.Resize(ITEMS_COUNT, 0.0f);
+            for (int n = 0; n < ITEMS_COUNT; n++)
+                heights.SetHeight(n, lines_count[n] * TEXT_BASE_HEIGHT + ROW_PADDING_Y);
+        }
+
+        ImVec2 outer_size = ImVec2(0.0f, TEXT_BASE_HEIGHT * 12);
+        if (ImGui::BeginTable("table_scrolly_variable", 2, flags, outer_size))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1); // Make top row always visible
+            ImGui::TableSetupColumn("Index", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("Lines", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(&heights);
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    char label[32];
+                    sprintf(label, "%d", row);
+                    if (ImGui::Selectable(label, lines_count[row] == 5, ImGuiSelectableFlags_SpanAllColumns))
+                    {
+                        lines_count[row] = (lines_count[row] == 5) ? ((row % 5 == 0) ? 3 : 1) : 5;
+                        heights.SetHeight(row, lines_count[row] * TEXT_BASE_HEIGHT + ROW_PADDING_Y);
+                    }
+                    ImGui::TableSetColumnIndex(1);
+                    for (int line = 0; line < lines_count[row]; line++)
+                        ImGui::Text("Row %d, line %d", row, line);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::TreePop();
+    }
+
     if (open_action != -1)
         ImGui::SetNextItemOpen(open_action != 0);
     IMGUI_DEMO_MARKER("Tables/Horizontal scrolling");
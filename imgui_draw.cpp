@@ -393,6 +393,7 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 void ImDrawList::_ResetForNewFrame()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     // Verify that the ImDrawCmd fields we want to memcmp() are contiguous in memory.
     IM_STATIC_ASSERT(offsetof(ImDrawCmd, ClipRect) == 0);
     IM_STATIC_ASSERT(offsetof(ImDrawCmd, TextureId) == sizeof(ImVec4));
@@ -433,6 +434,7 @@ void ImDrawList::_ClearFreeMemory()
 
 ImDrawList* ImDrawList::CloneOutput() const
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
@@ -443,6 +445,7 @@ ImDrawList* ImDrawList::CloneOutput() const
 
 void ImDrawList::AddDrawCmd()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TextureId = _CmdHeader.TextureId;
@@ -578,6 +581,7 @@ int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(const ImVec2& cr_min, const ImVec2& cr_max, bool intersect_with_current_clip_rect)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect)
     {
@@ -609,6 +613,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     _TextureIdStack.push_back(texture_id);
     _CmdHeader.TextureId = texture_id;
     _OnChangedTextureID();
@@ -626,6 +631,7 @@ void ImDrawList::PopTextureID()
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
@@ -716,6 +722,7 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -974,6 +981,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 // - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
 void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -1056,6 +1064,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 
 void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (radius < 0.5f)
     {
         _Path.push_back(center);
@@ -1148,6 +1157,7 @@ void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_
 
 void ImDrawList::_PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (radius < 0.5f)
     {
         _Path.push_back(center);
@@ -1177,6 +1187,7 @@ void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_
 
 void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (radius < 0.5f)
     {
         _Path.push_back(center);
@@ -1227,6 +1238,7 @@ void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, floa
 
 void ImDrawList::PathEllipticalArcTo(const ImVec2& center, const ImVec2& radius, float rot, float a_min, float a_max, int num_segments)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (num_segments <= 0)
         num_segments = _CalcCircleAutoSegmentCount(ImMax(radius.x, radius.y)); // A bit pessimistic, maybe there's a better computation to do here.
 
@@ -1310,6 +1322,7 @@ static void PathBezierQuadraticCurveToCasteljau(ImVector<ImVec2>* path, float x1
 
 void ImDrawList::PathBezierCubicCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImVec2 p1 = _Path.back();
     if (num_segments == 0)
     {
@@ -1326,6 +1339,7 @@ void ImDrawList::PathBezierCubicCurveTo(const ImVec2& p2, const ImVec2& p3, cons
 
 void ImDrawList::PathBezierQuadraticCurveTo(const ImVec2& p2, const ImVec2& p3, int num_segments)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImVec2 p1 = _Path.back();
     if (num_segments == 0)
     {
@@ -1931,6 +1945,7 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
 // Caller can build AABB of points, and avoid filling if 'draw_list->_CmdHeader.ClipRect.Overlays(points_bb) == false')
 void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -2041,6 +2056,7 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     IM_UNUSED(draw_list);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
@@ -2071,6 +2087,7 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
         return;
@@ -2181,6 +2198,7 @@ void ImDrawData::Clear()
 // as long at it is expected that the result will be later merged into draw_data->CmdLists[].
 void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     if (draw_list->CmdBuffer.Size == 0)
         return;
     if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
@@ -2450,6 +2468,7 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     // Build atlas on demand
     if (TexPixelsAlpha8 == NULL)
         Build();
@@ -2462,6 +2481,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -2486,6 +2506,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
@@ -2558,6 +2579,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     size_t data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
@@ -2594,6 +2616,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* font_data, int font_data_size, f
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -2606,6 +2629,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     int compressed_ttf_size = (((int)strlen(compressed_ttf_data_base85) + 4) / 5) * 4;
     void* compressed_ttf = IM_ALLOC((size_t)compressed_ttf_size);
     Decode85((const unsigned char*)compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -2616,6 +2640,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
 
 int ImFontAtlas::AddCustomRectRegular(int width, int height)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
     ImFontAtlasCustomRect r;
@@ -2627,6 +2652,7 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
 #ifdef IMGUI_USE_WCHAR32
     IM_ASSERT(id <= IM_UNICODE_CODEPOINT_MAX);
 #endif
@@ -2675,6 +2701,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
 
     // Default font is none are specified
@@ -3576,10 +3603,12 @@ ImFont::ImFont()
     ConfigData = NULL;
     ConfigDataCount = 0;
     DirtyLookupTables = false;
+    AsciiAdvanceXIntegral = false;
     Scale = 1.0f;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    TextRunCache = NULL;
 }
 
 ImFont::~ImFont()
@@ -3599,6 +3628,9 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    if (TextRunCache)
+        IM_DELETE(TextRunCache);
+    TextRunCache = NULL;
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3609,8 +3641,23 @@ static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_cha
     return (ImWchar)-1;
 }
 
+// Whole pixel advances, small enough for IM_FONT_ASCII_CHUNK_MAX of them to add up exactly in float (see ImFontSumAsciiAdvanceX)
+static bool ImFontIsAsciiAdvanceXIntegral(const ImFont* font)
+{
+    if (font->IndexAdvanceX.Size < 0x80)
+        return false;
+    for (int c = 0; c < 0x80; c++)
+    {
+        const float advance_x = font->IndexAdvanceX.Data[c];
+        if (advance_x < 0.0f || advance_x > 4096.0f || advance_x != (float)(int)advance_x)
+            return false;
+    }
+    return true;
+}
+
 void ImFont::BuildLookupTable()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
@@ -3691,6 +3738,13 @@ void ImFont::BuildLookupTable()
         EllipsisCharStep = (glyph->X1 - glyph->X0) + 1.0f;
         EllipsisWidth = EllipsisCharStep * 3.0f - 1.0f;
     }
+
+    AsciiAdvanceXIntegral = ImFontIsAsciiAdvanceXIntegral(this);
+
+    // Cached glyph quads refer to the glyphs we just built
+    if (TextRunCache)
+        IM_DELETE(TextRunCache);
+    TextRunCache = (ContainerAtlas && (ContainerAtlas->Flags & ImFontAtlasFlags_TextRunCache)) ? IM_NEW(ImFontTextRunCache)() : NULL;
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3710,6 +3764,8 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
 {
     if (ImFontGlyph* glyph = (ImFontGlyph*)(void*)FindGlyph((ImWchar)c))
         glyph->Visible = visible ? 1 : 0;
+    if (TextRunCache)
+        TextRunCache->Clear();
 }
 
 void ImFont::GrowIndex(int new_size)
@@ -3726,6 +3782,7 @@ void ImFont::GrowIndex(int new_size)
 // 'cfg' is not necessarily == 'this->ConfigData' because multiple source fonts+configs can be used to build one target font.
 void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     if (cfg != NULL)
     {
         // Clamp & recenter if needed
@@ -3770,6 +3827,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
     unsigned int index_size = (unsigned int)IndexLookup.Size;
 
@@ -3781,6 +3839,9 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    AsciiAdvanceXIntegral = ImFontIsAsciiAdvanceXIntegral(this);
+    if (TextRunCache)
+        TextRunCache->Clear();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -3813,6 +3874,84 @@ static inline const char* CalcWordWrapNextLineStartA(const char* text, const cha
     return text;
 }
 
+// Fast paths for ASCII text: find the end of a run of characters which can be measured with a flat lookup in IndexAdvanceX[],
+// 16 bytes at a time with SSE2. The scalar loop finishes the last block, so text_end is never read past.
+// - Plain run: ASCII characters other than '\n' and '\r'.
+// - Word run: ASCII characters which can't end a word in CalcWordWrapPositionA(): no blanks, control characters or punctuation.
+// Sums of whole pixel widths below 2^24 are exact in float, in any order: when AsciiAdvanceXIntegral is set, chunks of characters
+// are summed with independent accumulators then added to a whole pixel width below 2^23, giving the same result as adding each one.
+#define IM_FONT_ASCII_CHUNK_MAX         1024        // * 4096 max advance = 2^22
+#define IM_FONT_ASCII_WIDTH_EXACT_MAX   8388608.0f  // 2^23
+
+static inline bool ImCharIsWordRunA(char c)
+{
+    return (unsigned char)c > ' ' && (unsigned char)c < 0x80 && c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"';
+}
+
+static const char* ImTextFindPlainRunEndA(const char* text, const char* text_end)
+{
+    const char* s = text;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; text_end - s >= 16; s += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)s);
+        const __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(chars, lf), _mm_cmpeq_epi8(chars, cr));
+        if (_mm_movemask_epi8(_mm_or_si128(chars, stop)) != 0) // High bit set: non-ASCII byte, '\n' or '\r'
+            break;
+    }
+#endif
+    while (s < text_end && (unsigned char)*s < 0x80 && *s != '\n' && *s != '\r')
+        s++;
+    return s;
+}
+
+static const char* ImTextFindWordRunEndA(const char* text, const char* text_end)
+{
+    const char* s = text;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128i first_word_char = _mm_set1_epi8(' ' + 1);
+    for (; text_end - s >= 16; s += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)s);
+        __m128i stop = _mm_cmplt_epi8(chars, first_word_char); // Signed compare: non-ASCII bytes are negative
+        stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.')), _mm_cmpeq_epi8(chars, _mm_set1_epi8(','))));
+        stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(';')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('!'))));
+        stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('?')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\"'))));
+        if (_mm_movemask_epi8(stop) != 0)
+            break;
+    }
+#endif
+    while (s < text_end && ImCharIsWordRunA(*s))
+        s++;
+    return s;
+}
+
+// Length of the chunk of [text, text_end) summed at once: a multiple of 4, at most IM_FONT_ASCII_CHUNK_MAX
+static inline int ImFontCalcAsciiChunkLen(const char* text, const char* text_end)
+{
+    return ImMin((int)(text_end - text), IM_FONT_ASCII_CHUNK_MAX) & ~3;
+}
+
+static float ImFontSumAsciiAdvanceX(const float* advance_x, const char* text, const char* text_end)
+{
+    float w0 = 0.0f, w1 = 0.0f, w2 = 0.0f, w3 = 0.0f;
+    for (const char* s = text; s < text_end; s += 4)
+    {
+        w0 += advance_x[(unsigned char)s[0]];
+        w1 += advance_x[(unsigned char)s[1]];
+        w2 += advance_x[(unsigned char)s[2]];
+        w3 += advance_x[(unsigned char)s[3]];
+    }
+    return (w0 + w1) + (w2 + w3);
+}
+
+static inline bool ImFontIsWidthExact(float w)
+{
+    return w < IM_FONT_ASCII_WIDTH_EXACT_MAX && w == (float)(int)w;
+}
+
 // Simple word-wrapping for English, not full-featured. Please submit failing cases!
 // This will return the next location to wrap from. If no wrapping if necessary, this will fast-forward to e.g. text_end.
 // FIXME: Much possible improvements (don't cut things like "word !", "word!!!" but cut within "word,,,,", more sensible support for punctuations, support for Unicode punctuations, etc.)
@@ -3838,10 +3977,44 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* prev_word_end = NULL;
     bool inside_word = true;
 
+    // Flat lookup for ASCII characters, when the font covers them
+    const float* ascii_advance_x = (IndexAdvanceX.Size >= 0x80) ? IndexAdvanceX.Data : NULL;
+
     const char* s = text;
     IM_ASSERT(text_end != NULL);
     while (s < text_end)
     {
+        // Fast path: rest of the current word, same operations as the loop below without the state machine
+        if (inside_word && ascii_advance_x != NULL && ImCharIsWordRunA(*s))
+        {
+            const char* run_end = ImTextFindWordRunEndA(s, text_end);
+            if (AsciiAdvanceXIntegral && ImFontIsWidthExact(line_width) && ImFontIsWidthExact(word_width))
+                while (int chunk_len = ImFontCalcAsciiChunkLen(s, run_end))
+                {
+                    // Widths only grow: if the whole chunk fits, each of its characters did
+                    const float chunk_width = ImFontSumAsciiAdvanceX(ascii_advance_x, s, s + chunk_len);
+                    if (line_width + (word_width + chunk_width) > wrap_width || !ImFontIsWidthExact(line_width + (word_width + chunk_width)))
+                        break;
+                    word_width += chunk_width;
+                    s += chunk_len;
+                }
+            for (; s < run_end; s++)
+            {
+                word_width += ascii_advance_x[(unsigned char)*s];
+                if (line_width + word_width > wrap_width)
+                    break;
+            }
+            if (s < run_end)
+            {
+                word_end = s + 1;
+                if (word_width < wrap_width)
+                    s = prev_word_end ? prev_word_end : word_end;
+                break;
+            }
+            word_end = s;
+            continue;
+        }
+
         unsigned int c = (unsigned int)*s;
         const char* next_s;
         if (c < 0x80)
@@ -3928,6 +4101,9 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Flat lookup for ASCII characters, when the font covers them
+    const float* ascii_advance_x = (IndexAdvanceX.Size >= 0x80) ? IndexAdvanceX.Data : NULL;
+
     const char* s = text_begin;
     while (s < text_end)
     {
@@ -3949,6 +4125,32 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path: run of ASCII characters up to the next line break or wrapping point
+        if (ascii_advance_x != NULL && (unsigned char)*s < 0x80 && *s != '\n' && *s != '\r')
+        {
+            const char* run_end = ImTextFindPlainRunEndA(s, word_wrap_eol ? word_wrap_eol : text_end);
+            if (AsciiAdvanceXIntegral && scale == 1.0f && ImFontIsWidthExact(line_width))
+                while (int chunk_len = ImFontCalcAsciiChunkLen(s, run_end))
+                {
+                    // Widths only grow: if the whole chunk fits, each of its characters did
+                    const float chunk_width = ImFontSumAsciiAdvanceX(ascii_advance_x, s, s + chunk_len);
+                    if (line_width + chunk_width >= max_width || !ImFontIsWidthExact(line_width + chunk_width))
+                        break;
+                    line_width += chunk_width;
+                    s += chunk_len;
+                }
+            for (; s < run_end; s++)
+            {
+                const float char_width = ascii_advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -4007,6 +4209,162 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+void ImFontTextRunCache::Clear()
+{
+    Runs.resize(0);
+    Slots.resize(IM_FONT_TEXT_RUN_CACHE_MAX_RUNS * 2);
+    memset(Slots.Data, 0, (size_t)Slots.size_in_bytes());
+    if (SeenHashes.Size == 0)
+    {
+        SeenHashes.resize(IM_FONT_TEXT_RUN_CACHE_MAX_RUNS);
+        memset(SeenHashes.Data, 0, (size_t)SeenHashes.size_in_bytes());
+    }
+    TextBuf.resize(0);
+    Quads.resize(0);
+}
+
+const ImFontTextRun* ImFontTextRunCache::Find(ImGuiID hash, float size, const char* text, int text_len) const
+{
+    const int mask = Slots.Size - 1;
+    for (int slot = (int)(hash & mask); Slots[slot] != 0; slot = (slot + 1) & mask)
+    {
+        const ImFontTextRun* run = &Runs[Slots[slot] - 1];
+        if (run->Hash == hash && run->Size == size && run->TextLen == text_len && memcmp(TextBuf.Data + run->TextOffset, text, (size_t)text_len) == 0)
+            return run;
+    }
+    return NULL;
+}
+
+// Caller adds the run quads at the end of Quads
+ImFontTextRun* ImFontTextRunCache::Add(ImGuiID hash, float size, const char* text, int text_len)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
+    // Every character may add a quad
+    if (Runs.Size >= IM_FONT_TEXT_RUN_CACHE_MAX_RUNS || Quads.Size + text_len > IM_FONT_TEXT_RUN_CACHE_MAX_QUADS)
+        Clear();
+    const int mask = Slots.Size - 1;
+    int slot = (int)(hash & mask);
+    while (Slots[slot] != 0)
+        slot = (slot + 1) & mask;
+    Slots[slot] = Runs.Size + 1;
+
+    ImFontTextRun run;
+    run.Hash = hash;
+    run.Size = size;
+    run.TextOffset = TextBuf.Size;
+    run.TextLen = text_len;
+    run.QuadOffset = Quads.Size;
+    run.QuadCount = 0;
+    TextBuf.resize(TextBuf.Size + text_len);
+    memcpy(TextBuf.Data + run.TextOffset, text, (size_t)text_len);
+    Runs.push_back(run);
+    return &Runs.back();
+}
+
+// Render a single line of text from its cached glyph quads. Returns false when the text can't be cached (yet).
+// Quads are laid out exactly like RenderText() does, relative to the text position.
+// Updates the cache of a const font: see ImFontTextRunCache for the threading restriction.
+static bool ImFontRenderTextFromRunCache(const ImFont* font, ImDrawList* draw_list, float size, float x, float y, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end)
+{
+    ImFontTextRunCache* cache = font->TextRunCache;
+    const int text_len = (int)(text_end - text_begin);
+    if (text_len == 0 || text_len > IM_FONT_TEXT_RUN_MAX_LEN || memchr(text_begin, '\n', (size_t)text_len) != NULL)
+        return false;
+
+    const float scale = size / font->FontSize;
+    if (y + font->FontSize * scale < clip_rect.y)
+        return true;
+
+    const ImGuiID hash = ImHashData(text_begin, (size_t)text_len, ImHashData(&size, sizeof(size)));
+    const ImFontTextRun* run = cache->Find(hash, size, text_begin, text_len);
+    if (run == NULL)
+    {
+        // Only cache texts drawn at least twice
+        cache->Misses++;
+        ImGuiID& seen_hash = cache->SeenHashes[hash & (cache->SeenHashes.Size - 1)];
+        if (seen_hash != hash)
+        {
+            seen_hash = hash;
+            return false;
+        }
+
+        ImFontTextRun* new_run = cache->Add(hash, size, text_begin, text_len);
+        float run_x = 0.0f;
+        for (const char* s = text_begin; s < text_end;)
+        {
+            unsigned int c = (unsigned int)*s;
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == '\r')
+                continue;
+
+            const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c);
+            if (glyph == NULL)
+                continue;
+            if (glyph->Visible)
+            {
+                ImFontTextRunQuad quad;
+                quad.X0 = run_x + glyph->X0 * scale;
+                quad.X1 = run_x + glyph->X1 * scale;
+                quad.Y0 = glyph->Y0 * scale;
+                quad.Y1 = glyph->Y1 * scale;
+                quad.U0 = glyph->U0; quad.V0 = glyph->V0;
+                quad.U1 = glyph->U1; quad.V1 = glyph->V1;
+                quad.Colored = glyph->Colored != 0;
+                cache->Quads.push_back(quad);
+                new_run->QuadCount++;
+            }
+            run_x += glyph->AdvanceX * scale;
+        }
+        run = new_run;
+    }
+    else
+    {
+        cache->Hits++;
+    }
+    if (run->QuadCount == 0)
+        return true;
+
+    // Same clipping test as RenderText(): quads entirely left or right of the clip rect are skipped
+    const int idx_expected_size = draw_list->IdxBuffer.Size + run->QuadCount * 6;
+    draw_list->PrimReserve(run->QuadCount * 6, run->QuadCount * 4);
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    const ImFontTextRunQuad* quad = &cache->Quads[run->QuadOffset];
+    for (const ImFontTextRunQuad* quad_end = quad + run->QuadCount; quad < quad_end; quad++)
+    {
+        const float x1 = x + quad->X0;
+        const float x2 = x + quad->X1;
+        if (x1 > clip_rect.z || x2 < clip_rect.x)
+            continue;
+        const float y1 = y + quad->Y0;
+        const float y2 = y + quad->Y1;
+        const ImU32 glyph_col = quad->Colored ? col_untinted : col;
+        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = quad->U0; vtx_write[0].uv.y = quad->V0;
+        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = quad->U1; vtx_write[1].uv.y = quad->V0;
+        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = quad->U1; vtx_write[2].uv.y = quad->V1;
+        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = quad->U0; vtx_write[3].uv.y = quad->V1;
+        idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+        idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+        vtx_write += 4;
+        vtx_index += 4;
+        idx_write += 6;
+    }
+
+    // Give back unused vertices (clipped ones)
+    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data);
+    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_index;
+    return true;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
@@ -4019,6 +4377,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (y > clip_rect.w)
         return;
 
+    // Short single-line text drawn again: copy its cached glyph quads
+    if (TextRunCache != NULL && wrap_width <= 0.0f && !cpu_fine_clip)
+        if (ImFontRenderTextFromRunCache(this, draw_list, size, x, y, col, clip_rect, text_begin, text_end))
+            return;
+
     const float start_x = x;
     const float scale = size / FontSize;
     const float line_height = FontSize * scale;
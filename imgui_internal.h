@@ -60,6 +60,17 @@ Index of this file:
 #define IMGUI_ENABLE_SSE
 #include <immintrin.h>
 #endif
+#if defined(IMGUI_ENABLE_SSE) && (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_ENABLE_SSE2
+#endif
+
+// SSE 4.2 CRC32 instructions in ImHashData()/ImHashStr() are opt-in, as they change IDs (see imconfig.h)
+#ifdef IMGUI_ENABLE_SSE4_2_CRC
+#if !defined(IMGUI_ENABLE_SSE) || !(defined __SSE4_2__ || defined __AVX__)
+#error "IMGUI_ENABLE_SSE4_2_CRC requires compiling with SSE 4.2 enabled (e.g. -msse4.2, or /arch:AVX with MSVC)"
+#endif
+#include <nmmintrin.h>
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -139,9 +150,12 @@ struct ImGuiInputTextDeactivateData;// Short term storage to backup text of a de
 struct ImGuiLastItemData;           // Status storage for last submitted items
 struct ImGuiLocEntry;               // A localization entry.
 struct ImGuiMenuColumns;            // Simple column measurement, currently used for MenuItem() only
+struct ImGuiMultiSelectState;       // Multi-selection persistent state (for focused selection).
+struct ImGuiMultiSelectTempData;    // Multi-selection temporary state (while traversing).
 struct ImGuiNavItemData;            // Result of a gamepad/keyboard directional navigation move query result
 struct ImGuiNavTreeNodeData;        // Temporary storage for last TreeNode() being a Left arrow landing candidate.
 struct ImGuiMetricsConfig;          // Storage for ShowMetricsWindow() and DebugNodeXXX() functions
+struct ImGuiProfiler;               // Storage for the frame profiler (ProfilerPushScope()/ProfilerPopScope())
 struct ImGuiNextWindowData;         // Storage for SetNextWindow** functions
 struct ImGuiNextItemData;           // Storage for SetNextItem** functions
 struct ImGuiOldColumnData;          // Storage data for a single column for legacy Columns() api
@@ -158,6 +172,7 @@ struct ImGuiTableInstanceData;      // Storage for one instance of a same table
 struct ImGuiTableTempData;          // Temporary storage for one table (one per table in the stack), shared between tables.
 struct ImGuiTableSettings;          // Storage for a table .ini settings
 struct ImGuiTableColumnsSettings;   // Storage for a column .ini settings
+struct ImGuiTextWrapCache;          // Storage for the wrapped lines of a long text
 struct ImGuiTypingSelectState;      // Storage for GetTypingSelectRequest()
 struct ImGuiTypingSelectRequest;    // Storage for GetTypingSelectRequest() (aimed to be public)
 struct ImGuiWindow;                 // Storage for one window
@@ -169,6 +184,7 @@ struct ImGuiWindowSettings;         // Storage for a window .ini settings (we ke
 enum ImGuiLocKey : int;                 // -> enum ImGuiLocKey              // Enum: a localization entry for translation.
 typedef int ImGuiDataAuthority;         // -> enum ImGuiDataAuthority_      // Enum: for storing the source authority (dock node vs window) of a field
 typedef int ImGuiLayoutType;            // -> enum ImGuiLayoutType_         // Enum: Horizontal or vertical
+typedef int ImGuiMemTag;                // -> enum ImGuiMemTag_             // Enum: Subsystem an allocation is accounted to (IMGUI_DEBUG_MEM_TAGS)
 
 // Flags
 typedef int ImGuiActivateFlags;         // -> enum ImGuiActivateFlags_      // Flags: for navigation/focus function (will be for ActivateItem() later)
@@ -675,6 +691,40 @@ struct ImSpanAllocator
     inline void  GetSpan(int n, ImSpan<T>* span)    { span->set((T*)GetSpanPtrBegin(n), (T*)GetSpanPtrEnd(n)); }
 };
 
+// Helper: ImFrameArena
+// Linear allocator for scratch memory that lives until the next Reset(). The context's one is reset by NewFrame(), see ImGui::MemAllocFrame().
+// - Alloc() bumps an offset in the current chunk, and adds a chunk twice as large when it is full. Nothing is freed individually.
+// - Reset() merges the chunks into one with twice the room used by the last two frames, so that a repeating frame allocates from a single chunk
+//   and never calls MemAlloc(). A chunk left over twice too large is shrunk.
+// - Sizes over half a minimum chunk (e.g. a large pasted text) are one-off MemAlloc() calls freed by the next Reset(), they don't grow the chunks.
+#define IM_FRAME_ARENA_MIN_CHUNK_SIZE   (64 * 1024)
+
+struct ImFrameArenaChunk
+{
+    char*   Data;
+    size_t  Size;
+};
+
+struct ImFrameArena
+{
+    ImVector<ImFrameArenaChunk> Chunks;     // Last one is the current one
+    ImVector<void*> LargeAllocs;            // Allocations too large for the chunks, freed by the next Reset()
+    size_t  CurrOff;                        // Offset in the current chunk
+    size_t  UsedBytes;                      // Allocated from the chunks since the last Reset() (with alignment padding)
+    int     AllocCount;                     // Number of Alloc() calls since the last Reset()
+    size_t  LastUsedBytes;                  // UsedBytes before the last Reset()
+    int     LastAllocCount;                 // AllocCount before the last Reset()
+    size_t  PeakUsedBytes;                  // Highest UsedBytes before a Reset()
+    int     ChunkAllocCount;                // Number of MemAlloc() calls for chunks, over the lifetime of the arena
+
+    ImFrameArena()                          { CurrOff = UsedBytes = LastUsedBytes = PeakUsedBytes = 0; AllocCount = LastAllocCount = ChunkAllocCount = 0; }
+    ~ImFrameArena()                         { Clear(); }
+    IMGUI_API void* Alloc(size_t size);     // Aligned on 16 bytes (relative to the chunk, itself aligned as MemAlloc() is). Return NULL if size overflows.
+    IMGUI_API void  Reset();
+    IMGUI_API void  Clear();                // Reset() and free all chunks
+    size_t          GetCapacity() const     { size_t sz = 0; for (const ImFrameArenaChunk& chunk : Chunks) sz += chunk.Size; return sz; }
+};
+
 // Helper: ImPool<>
 // Basic keyed storage for contiguous instances, slow/amortized insertion, O(1) indexable, O(Log N) queries by ID over a dense/hot buffer,
 // Honor constructor/destructor. Add/remove invalidate all pointers. Indexes have the same lifetime as the associated object.
@@ -1172,10 +1222,6 @@ struct ImGuiNextWindowData
     inline void ClearFlags()    { Flags = ImGuiNextWindowDataFlags_None; }
 };
 
-// Multi-Selection item index or identifier when using SetNextItemSelectionUserData()/BeginMultiSelect()
-// (Most users are likely to use this store an item INDEX but this may be used to store a POINTER as well.)
-typedef ImS64 ImGuiSelectionUserData;
-
 enum ImGuiNextItemDataFlags_
 {
     ImGuiNextItemDataFlags_None         = 0,
@@ -1265,6 +1311,24 @@ struct ImGuiPtrOrIndex
     ImGuiPtrOrIndex(int index)  { Ptr = NULL; Index = index; }
 };
 
+// Wrapped lines of a long text submitted with word-wrapping, kept across frames (see TextEx()).
+// Lines all have the same height: the visible ones are found from the clipping rectangle, and only those are rendered.
+// Found from the window, text pointer and length, font and wrap width. The whole text is only hashed when its pointer or length changes.
+struct ImGuiTextWrapCache
+{
+    ImGuiID         WindowID;
+    int             TextLen;
+    ImGuiID         TextHash;       // Hash of the whole text (seeded with WindowID)
+    ImFont*         Font;
+    float           FontSize;
+    float           WrapWidth;
+    float           Width;          // Width of the widest line (not rounded)
+    int             LastFrameUsed;  // Dropped when not used for a frame
+    ImVector<int>   LineStarts;     // Offset of each line in the text
+
+    ImGuiTextWrapCache()            { WindowID = TextHash = 0; TextLen = 0; Font = NULL; FontSize = WrapWidth = Width = 0.0f; LastFrameUsed = -1; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Data types support
 //-----------------------------------------------------------------------------
@@ -1736,7 +1800,34 @@ struct ImGuiOldColumns
 #define ImGuiSelectionUserData_Invalid        ((ImGuiSelectionUserData)-1)
 
 #ifdef IMGUI_HAS_MULTI_SELECT
-// <this is filled in 'range_select' branch>
+
+// Temporary storage for the current BeginMultiSelect()/EndMultiSelect() block (they cannot be nested)
+struct IMGUI_API ImGuiMultiSelectTempData
+{
+    ImGuiMultiSelectIO      IO;                 // Requests are set and returned by BeginMultiSelect()/EndMultiSelect()
+    ImGuiMultiSelectState*  Storage;
+    ImGuiID                 FocusScopeId;       // Pushed by BeginMultiSelect()
+    ImGuiMultiSelectFlags   Flags;
+    ImGuiKeyChord           KeyMods;            // Key mods at the time of BeginMultiSelect()
+    bool                    IsFocused;          // Set if currently focusing the selection scope (any item of the selection)
+    bool                    IsEndIO;            // Set once IO holds the requests for EndMultiSelect() rather than the ones of BeginMultiSelect()
+
+    ImGuiMultiSelectTempData()  { Clear(); }
+    void Clear()                { IO.Requests.resize(0); IO.RangeSrcItem = IO.NavIdItem = ImGuiSelectionUserData_Invalid; IO.ItemsCount = -1; Storage = NULL; FocusScopeId = 0; Flags = ImGuiMultiSelectFlags_None; KeyMods = ImGuiMod_None; IsFocused = IsEndIO = false; }
+};
+
+// Persistent storage for a multi-select scope, keyed on the ID stack at BeginMultiSelect()
+struct IMGUI_API ImGuiMultiSelectState
+{
+    ImGuiID                 ID;
+    float                   LastTimeActive;     // Last used timestamp, for GC (see io.ConfigMemoryCompactTimer)
+    bool                    RangeSelected;      // Selected state of RangeSrcItem, applied to Ctrl+Shift ranges
+    ImGuiSelectionUserData  RangeSrcItem;       // Anchor of Shift ranges
+    ImGuiSelectionUserData  NavIdItem;          // SetNextItemSelectionUserData() value of the item which was last clicked or navigated to
+
+    ImGuiMultiSelectState() { ID = 0; LastTimeActive = -1.0f; RangeSelected = false; RangeSrcItem = NavIdItem = ImGuiSelectionUserData_Invalid; }
+};
+
 #endif // #ifdef IMGUI_HAS_MULTI_SELECT
 
 //-----------------------------------------------------------------------------
@@ -2037,12 +2128,50 @@ struct ImGuiDebugAllocInfo
 {
     int         TotalAllocCount;            // Number of call to MemAlloc().
     int         TotalFreeCount;
+    int         FramesWithAllocCount;       // Number of frames that called MemAlloc() at least once
     ImS16       LastEntriesIdx;             // Current index in buffer
     ImGuiDebugAllocEntry LastEntriesBuf[6]; // Track last 6 frames that had allocations
 
     ImGuiDebugAllocInfo() { memset(this, 0, sizeof(*this)); }
 };
 
+// Memory accounting by subsystem, with IMGUI_DEBUG_MEM_TAGS defined in imconfig.h
+// - MemAlloc() accounts an allocation to the tag of the innermost IM_MEM_TAG_SCOPE() it is called from, or to ImGuiMemTag_Other.
+// - Each allocation is prefixed with a 16 bytes header holding its size and tag, so that MemFree() can account it back.
+enum ImGuiMemTag_
+{
+    ImGuiMemTag_Other,
+    ImGuiMemTag_Windows,                    // ImGuiWindow, its settings and the buffers grown by Begin()
+    ImGuiMemTag_DrawLists,                  // ImDrawList buffers and ImDrawData
+    ImGuiMemTag_Tables,                     // ImGuiTable, its temporary data and settings
+    ImGuiMemTag_Storage,                    // ImGuiStorage pairs (windows state storage, pools)
+    ImGuiMemTag_Fonts,                      // Font atlas, fonts, glyphs and their caches
+    ImGuiMemTag_TextBuffer,                 // ImGuiTextBuffer (logging, .ini data, debug log)
+    ImGuiMemTag_FrameArena,                 // MemAllocFrame() chunks
+    ImGuiMemTag_COUNT
+};
+
+struct ImGuiMemTagStats
+{
+    size_t      Bytes;                      // Currently allocated
+    size_t      PeakBytes;
+    int         Count;                      // Current number of allocations
+    int         TotalCount;                 // Number of calls to MemAlloc()
+};
+
+#ifdef IMGUI_DEBUG_MEM_TAGS
+extern IMGUI_API thread_local ImGuiMemTag GImMemTag;  // Tag of allocations made now by this thread (MSVC can't export it from a DLL: use a static build)
+struct ImGuiMemTagScope
+{
+    ImGuiMemTag BackupTag;
+    ImGuiMemTagScope(ImGuiMemTag tag)       { BackupTag = GImMemTag; GImMemTag = tag; }
+    ~ImGuiMemTagScope()                     { GImMemTag = BackupTag; }
+};
+#define IM_MEM_TAG_SCOPE(_TAG)              ImGuiMemTagScope im_mem_tag_scope(_TAG)
+#else
+#define IM_MEM_TAG_SCOPE(_TAG)              (void)0
+#endif
+
 struct ImGuiMetricsConfig
 {
     bool        ShowDebugLog = false;
@@ -2059,8 +2188,56 @@ struct ImGuiMetricsConfig
     int         ShowTablesRectsType = -1;
     int         HighlightMonitorIdx = -1;
     ImGuiID     HighlightViewportID = 0;
+    int         ProfilerFrameOffset = 1;    // Frame shown by Metrics->Profiler, 0 = most recent (still in progress unless paused)
 };
 
+// Frame profiler: timed scopes and frames are kept in ring buffers, see ProfilerPushScope()/ProfilerPopScope() and IM_PROFILE_SCOPE().
+#define IM_PROFILER_EVENTS_COUNT    4096
+#define IM_PROFILER_FRAMES_COUNT    128
+
+struct ImGuiProfilerEvent
+{
+    const char* Name;
+    ImU64       StartNs;
+    ImU64       EndNs;
+    int         FrameCount;                 // Frame the scope ended in
+    int         Depth;                      // Number of scopes open around this one
+};
+
+struct ImGuiProfilerFrame
+{
+    int         FrameCount;
+    ImU64       StartNs;                    // When NewFrame() was called
+};
+
+struct ImGuiProfiler
+{
+    bool                            Paused;             // Don't record anything (set from Metrics->Profiler)
+    ImVector<ImGuiProfilerEvent>    OpenScopes;         // Stack of scopes pushed and not popped yet
+    ImVector<ImGuiProfilerEvent>    Events;             // Ring buffer of IM_PROFILER_EVENTS_COUNT scopes, allocated by the first one
+    int                             EventsIdx;          // Where to write the next event
+    int                             EventsCount;
+    ImGuiProfilerFrame              Frames[IM_PROFILER_FRAMES_COUNT];
+    int                             FramesIdx;          // Where to write the next frame
+    int                             FramesCount;
+
+    ImGuiProfiler()                                     { Paused = false; EventsIdx = EventsCount = FramesIdx = FramesCount = 0; memset(Frames, 0, sizeof(Frames)); }
+    void                            Clear()             { OpenScopes.clear(); Events.clear(); EventsIdx = EventsCount = FramesIdx = FramesCount = 0; }
+    const ImGuiProfilerEvent&       GetEvent(int n) const { IM_ASSERT(n >= 0 && n < EventsCount); return Events[(EventsIdx - EventsCount + n + IM_PROFILER_EVENTS_COUNT) % IM_PROFILER_EVENTS_COUNT]; }    // 0 = oldest
+    const ImGuiProfilerFrame&       GetFrame(int n) const { IM_ASSERT(n >= 0 && n < FramesCount); return Frames[(FramesIdx - FramesCount + n + IM_PROFILER_FRAMES_COUNT) % IM_PROFILER_FRAMES_COUNT]; }    // 0 = oldest
+};
+
+#ifdef IMGUI_ENABLE_PROFILER
+struct ImGuiProfilerScope
+{
+    ImGuiProfilerScope(const char* name)    { ImGui::ProfilerPushScope(name); }
+    ~ImGuiProfilerScope()                   { ImGui::ProfilerPopScope(); }
+};
+#define IM_PROFILE_SCOPE(_NAME)             ImGuiProfilerScope im_profile_scope(_NAME)
+#else
+#define IM_PROFILE_SCOPE(_NAME)             (void)0
+#endif
+
 struct ImGuiStackLevelInfo
 {
     ImGuiID                 ID;
@@ -2336,12 +2513,20 @@ struct ImGuiContext
     ImVector<float>                 TablesLastTimeActive;       // Last used timestamp of each tables (SOA, for efficient GC)
     ImVector<ImDrawChannel>         DrawChannelsTempMergeBuffer;
 
+    // Multi-Select state
+    ImGuiMultiSelectTempData*       CurrentMultiSelect;         // Set between BeginMultiSelect() and EndMultiSelect()
+    ImGuiMultiSelectTempData        MultiSelectTempData;
+    ImPool<ImGuiMultiSelectState>   MultiSelectStorage;
+
     // Tab bars
     ImGuiTabBar*                    CurrentTabBar;
     ImPool<ImGuiTabBar>             TabBars;
     ImVector<ImGuiPtrOrIndex>       CurrentTabBarStack;
     ImVector<ImGuiShrinkWidthItem>  ShrinkWidthBuffer;
 
+    // Long wrapped texts
+    ImVector<ImGuiTextWrapCache*>   TextWrapCaches;             // Only a few long texts are visible at a time
+
     // Hover Delay system
     ImGuiID                 HoverItemDelayId;
     ImGuiID                 HoverItemDelayIdPreviousFrame;
@@ -2442,6 +2627,9 @@ struct ImGuiContext
     ImGuiMetricsConfig      DebugMetricsConfig;
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
+#ifdef IMGUI_ENABLE_PROFILER
+    ImGuiProfiler           Profiler;
+#endif
     ImGuiDockNode*          DebugHoveredDockNode;               // Hovered dock node.
 
     // Misc
@@ -2453,6 +2641,7 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;       // "
     int                     WantTextInputNextFrame;
     ImVector<char>          TempBuffer;                         // Temporary text buffer
+    ImFrameArena            FrameArena;                         // Scratch memory of MemAllocFrame(), reset by NewFrame()
     char                    TempKeychordName[64];
 
     ImGuiContext(ImFontAtlas* shared_font_atlas)
@@ -2584,6 +2773,7 @@ struct ImGuiContext
 
         CurrentTable = NULL;
         TablesTempDataStacked = 0;
+        CurrentMultiSelect = NULL;
         CurrentTabBar = NULL;
 
         HoverItemDelayId = HoverItemDelayIdPreviousFrame = HoverItemUnlockedStationaryId = HoverWindowUnlockedStationaryId = 0;
@@ -2750,6 +2940,10 @@ struct IMGUI_API ImGuiWindow
     ImVec2                  ScrollTarget;                       // target scroll position. stored as cursor position with scrolling canceled out, so the highest point is always 0.0f. (FLT_MAX for no change)
     ImVec2                  ScrollTargetCenterRatio;            // 0.0f = scroll so that target position is at top, 0.5f = scroll so that target position is centered
     ImVec2                  ScrollTargetEdgeSnapDist;           // 0.0f = no snapping, >0.0f snapping threshold
+    double                  LargeScrollBaseY;                   // ImGuiChildFlags_LargeScrollY: logical scroll position of the contents origin. Scroll.y and contents positions are relative to it.
+    double                  LargeScrollTargetY;                 // ImGuiChildFlags_LargeScrollY: logical scroll target (-1.0 for no change)
+    double                  LargeContentSizeY;                  // ImGuiChildFlags_LargeScrollY: logical contents height, from last frame
+    double                  LargeContentSizeSubmittedY;         // ImGuiChildFlags_LargeScrollY: logical contents height submitted by clippers during the frame
     ImVec2                  ScrollbarSizes;                     // Size taken by each scrollbars on their smaller axis. Pay attention! ScrollbarSizes.x == width of the vertical scrollbar, ScrollbarSizes.y = height of the horizontal scrollbar.
     bool                    ScrollbarX, ScrollbarY;             // Are scrollbars visible?
     bool                    ViewportOwned;
@@ -3319,6 +3513,7 @@ namespace ImGui
     IMGUI_API void          SetScrollY(ImGuiWindow* window, float scroll_y);
     IMGUI_API void          SetScrollFromPosX(ImGuiWindow* window, float local_x, float center_x_ratio);
     IMGUI_API void          SetScrollFromPosY(ImGuiWindow* window, float local_y, float center_y_ratio);
+    IMGUI_API void          SetLargeScrollY(ImGuiWindow* window, double scroll_y);
 
     // Early work-in-progress API (ScrollToItem() will become public)
     IMGUI_API void          ScrollToItem(ImGuiScrollFlags flags = 0);
@@ -3355,7 +3550,6 @@ namespace ImGui
     IMGUI_API ImVec2        CalcItemSize(ImVec2 size, float default_w, float default_h);
     IMGUI_API float         CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x);
     IMGUI_API void          PushMultiItemsWidths(int components, float width_full);
-    IMGUI_API bool          IsItemToggledSelection();                                   // Was the last item selection toggled? (after Selectable(), TreeNode() etc. We only returns toggle _event_ in order to handle clipping correctly)
     IMGUI_API ImVec2        GetContentRegionMaxAbs();
     IMGUI_API void          ShrinkWidths(ImGuiShrinkWidthItem* items, int count, float width_excess);
 
@@ -3734,7 +3928,10 @@ namespace ImGui
     IMGUI_API void          TreePushOverrideID(ImGuiID id);
     IMGUI_API void          TreeNodeSetOpen(ImGuiID id, bool open);
     IMGUI_API bool          TreeNodeUpdateNextOpen(ImGuiID id, ImGuiTreeNodeFlags flags);   // Return open state. Consume previous SetNextItemOpen() data, if any. May return true when logging.
-    IMGUI_API void          SetNextItemSelectionUserData(ImGuiSelectionUserData selection_user_data);
+
+    // Multi-Select API
+    IMGUI_API void          MultiSelectItemFooter(ImGuiID id, bool* p_selected, bool* p_pressed);
+    inline ImGuiMultiSelectState* GetMultiSelectState(ImGuiID id)   { ImGuiContext& g = *GImGui; return g.MultiSelectStorage.GetByKey(id); }
 
     // Template functions are instantiated in imgui_widgets.cpp for a finite number of types.
     // To use them externally (for custom widget) you may need an "extern template" statement in your code in order to link to existing instances and silence Clang warnings (see #2036).
@@ -3784,6 +3981,12 @@ namespace ImGui
     IMGUI_API void          DebugLog(const char* fmt, ...) IM_FMTARGS(1);
     IMGUI_API void          DebugLogV(const char* fmt, va_list args) IM_FMTLIST(1);
     IMGUI_API void          DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr, size_t size); // size >= 0 : alloc, size = -1 : free
+    IMGUI_API int           DebugGetFrameAllocCount(int frame_count);                      // Number of MemAlloc() calls during a frame, for one of the last 6 frames that had allocations (0 for others). e.g. DebugGetFrameAllocCount(GetFrameCount()) after Render().
+    IMGUI_API const ImGuiMemTagStats* DebugGetMemTagStats(ImGuiMemTag tag);                  // Requires IMGUI_DEBUG_MEM_TAGS, all zero without. Snapshot updated by each call, call from a single thread.
+    IMGUI_API const char*   DebugGetMemTagName(ImGuiMemTag tag);
+
+    // Profiler
+    IMGUI_API void          ProfilerExportChromeTrace(ImGuiTextBuffer* buf);
 
     // Debug Tools
     IMGUI_API void          ErrorCheckEndFrameRecover(ImGuiErrorLogCallback log_callback, void* user_data = NULL);
@@ -3806,6 +4009,7 @@ namespace ImGui
     IMGUI_API void          DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, const ImDrawList* draw_list, const ImDrawCmd* draw_cmd, bool show_mesh, bool show_aabb);
     IMGUI_API void          DebugNodeFont(ImFont* font);
     IMGUI_API void          DebugNodeFontGlyph(ImFont* font, const ImFontGlyph* glyph);
+    IMGUI_API void          DebugNodeProfiler();
     IMGUI_API void          DebugNodeStorage(ImGuiStorage* storage, const char* label);
     IMGUI_API void          DebugNodeTabBar(ImGuiTabBar* tab_bar, const char* label);
     IMGUI_API void          DebugNodeTable(ImGuiTable* table);
@@ -3849,6 +4053,48 @@ struct ImFontBuilderIO
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
 };
 
+// Glyph quads of short single-line texts recently drawn by ImFont::RenderText(), relative to the text position (ImFontAtlasFlags_TextRunCache).
+// A text is only cached the second time it is drawn, and the cache is cleared when full: texts which stay visible stay cached,
+// texts scrolled through once don't evict them.
+// The cache is owned by the ImFont but written by the const ImFont::RenderText(), without any locking: fonts of an atlas
+// built with ImFontAtlasFlags_TextRunCache must not be rendered from several threads at the same time.
+#define IM_FONT_TEXT_RUN_MAX_LEN            256         // Longer texts are rendered as usual
+#define IM_FONT_TEXT_RUN_CACHE_MAX_RUNS     4096
+#define IM_FONT_TEXT_RUN_CACHE_MAX_QUADS    (64 * 1024)
+
+struct ImFontTextRunQuad
+{
+    float               X0, Y0, X1, Y1;     // Relative to the text position
+    float               U0, V0, U1, V1;
+    bool                Colored;            // ImFontGlyph::Colored
+};
+
+struct ImFontTextRun
+{
+    ImGuiID             Hash;               // Hash of the font size and text
+    float               Size;
+    int                 TextOffset;         // In ImFontTextRunCache::TextBuf
+    int                 TextLen;
+    int                 QuadOffset;         // In ImFontTextRunCache::Quads
+    int                 QuadCount;
+};
+
+struct IMGUI_API ImFontTextRunCache
+{
+    ImVector<ImFontTextRun>     Runs;
+    ImVector<int>               Slots;          // Open addressing table of Runs indices + 1, 0 for empty slots
+    ImVector<ImGuiID>           SeenHashes;     // Hashes of texts drawn once, direct mapped
+    ImVector<char>              TextBuf;        // Texts of Runs, to tell hash collisions apart
+    ImVector<ImFontTextRunQuad> Quads;
+    int                         Hits;           // Texts drawn from the cache
+    int                         Misses;         // Texts decoded
+
+    ImFontTextRunCache()        { Hits = Misses = 0; Clear(); }
+    void                        Clear();
+    const ImFontTextRun*        Find(ImGuiID hash, float size, const char* text, int text_len) const;
+    ImFontTextRun*              Add(ImGuiID hash, float size, const char* text, int text_len);
+};
+
 // Helper for font builder
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 IMGUI_API const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype();
@@ -309,6 +309,7 @@ bool    ImGui::BeginTable(const char* str_id, int columns_count, ImGuiTableFlags
 
 bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImGuiTableFlags flags, const ImVec2& outer_size, float inner_width)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Tables);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* outer_window = GetCurrentWindow();
     if (outer_window->SkipItems) // Consistent with other tables + beneficial side effect that assert on miscalling EndTable() will be more visible.
@@ -770,6 +771,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(table->IsLayoutLocked == false);
+    IM_PROFILE_SCOPE("TableUpdateLayout");
 
     const ImGuiTableFlags table_sizing_policy = (table->Flags & ImGuiTableFlags_SizingMask_);
     table->IsDefaultDisplayOrder = true;
@@ -1309,6 +1311,7 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
 
 void    ImGui::EndTable()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Tables);
     ImGuiContext& g = *GImGui;
     ImGuiTable* table = g.CurrentTable;
     IM_ASSERT(table != NULL && "Only call EndTable() if BeginTable() returns true!");
@@ -2484,6 +2487,7 @@ void ImGui::TableSetupDrawChannels(ImGuiTable* table)
 void ImGui::TableMergeDrawChannels(ImGuiTable* table)
 {
     ImGuiContext& g = *GImGui;
+    IM_PROFILE_SCOPE("TableMergeDrawChannels");
     ImDrawListSplitter* splitter = table->DrawSplitter;
     const bool has_freeze_v = (table->FreezeRowsCount > 0);
     const bool has_freeze_h = (table->FreezeColumnsCount > 0);
@@ -3488,6 +3492,7 @@ static size_t TableSettingsCalcChunkSize(int columns_count)
 
 ImGuiTableSettings* ImGui::TableSettingsCreate(ImGuiID id, int columns_count)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Tables);
     ImGuiContext& g = *GImGui;
     ImGuiTableSettings* settings = g.SettingsTables.alloc_chunk(TableSettingsCalcChunkSize(columns_count));
     TableSettingsInit(settings, id, columns_count, columns_count);
@@ -3814,6 +3819,7 @@ void ImGui::TableGcCompactTransientBuffers(ImGuiTableTempData* temp_data)
 // Compact and remove unused settings data (currently only used by TestEngine)
 void ImGui::TableGcCompactSettings()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Tables);
     ImGuiContext& g = *GImGui;
     int required_memory = 0;
     for (ImGuiTableSettings* settings = g.SettingsTables.begin(); settings != NULL; settings = g.SettingsTables.next_chunk(settings))
@@ -146,6 +146,61 @@ static ImVec2   InputTextCalcTextSizeW(ImGuiContext* ctx, const ImWchar* text_be
 // - BulletTextV()
 //-------------------------------------------------------------------------
 
+// Wrapped lines of a long text, reused from the previous frame when the text, font and wrap width didn't change.
+// Each line is wrapped on its own, the way CalcTextSize() and RenderTextWrapped() wrap them.
+// Texts are keyed on a hash of their whole contents, not their address: a text formatted again in the same buffer (e.g. g.TempBuffer
+// for TextWrapped()) is looked up by what it says, and a moved text (e.g. a reallocated string) still finds its lines.
+static const ImGuiTextWrapCache* GetTextWrapCache(ImGuiWindow* window, const char* text, const char* text_end, float wrap_width)
+{
+    ImGuiContext& g = *GImGui;
+    const int text_len = (int)(text_end - text);
+    const ImGuiID text_hash = ImHashData(text, (size_t)text_len, window->ID);
+    for (ImGuiTextWrapCache* cache : g.TextWrapCaches)
+        if (cache->TextHash == text_hash && cache->TextLen == text_len && cache->WindowID == window->ID
+            && cache->Font == g.Font && cache->FontSize == g.FontSize && cache->WrapWidth == wrap_width)
+        {
+            cache->LastFrameUsed = g.FrameCount;
+            return cache;
+        }
+
+    ImGuiTextWrapCache* cache = IM_NEW(ImGuiTextWrapCache)();
+    g.TextWrapCaches.push_back(cache);
+    ImFont* font = g.Font;
+    const float scale = g.FontSize / font->FontSize;
+    cache->WindowID = window->ID;
+    cache->TextLen = text_len;
+    cache->TextHash = text_hash;
+    cache->Font = font;
+    cache->FontSize = g.FontSize;
+    cache->WrapWidth = wrap_width;
+    cache->LastFrameUsed = g.FrameCount;
+    const char* line_break = NULL; // Next '\n' or text_end
+    const char* s = text;
+    do
+    {
+        cache->LineStarts.push_back((int)(s - text));
+        if (line_break == NULL || line_break < s)
+        {
+            line_break = (const char*)memchr(s, '\n', text_end - s);
+            if (line_break == NULL)
+                line_break = text_end;
+        }
+        const char* line_end = font->CalcWordWrapPositionA(scale, s, line_break, wrap_width);
+        if (line_end == s + 1) // Forced to display one character: don't split it
+            line_end = s + ImTextCountUtf8BytesFromChar(s, line_break);
+        cache->Width = ImMax(cache->Width, font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, s, line_end).x);
+
+        // Wrapping skips upcoming blanks, and a line break after them
+        s = line_end;
+        while (s < line_break && (*s == ' ' || *s == '\t'))
+            s++;
+        if (s < text_end && *s == '\n')
+            s++;
+    }
+    while (s < text_end);
+    return cache;
+}
+
 void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -165,7 +220,31 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
     const float wrap_pos_x = window->DC.TextWrapPos;
     const bool wrap_enabled = (wrap_pos_x >= 0.0f);
-    if (text_end - text <= 2000 || wrap_enabled)
+    if (text_end - text > 2000 && wrap_enabled && !g.LogEnabled)
+    {
+        // Long wrapped text!
+        // - Wrapped lines are kept across frames, see GetTextWrapCache(). Following frames only look them up.
+        // - Lines all have the same height: find the first visible one directly and render from there.
+        const float wrap_width = CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x);
+        const ImGuiTextWrapCache* cache = GetTextWrapCache(window, text_begin, text_end, wrap_width);
+        const float line_height = g.FontSize;
+        const ImVec2 text_size(IM_TRUNC(cache->Width + 0.99999f), line_height * cache->LineStarts.Size);
+
+        ImRect bb(text_pos, text_pos + text_size);
+        ItemSize(text_size, 0.0f);
+        if (!ItemAdd(bb, 0))
+            return;
+
+        int line_n = ImMax((int)ImCeil((window->ClipRect.Min.y - text_pos.y) / line_height) - 1, 0); // Like RenderText(), lines touching the clipping rectangle are rendered
+        ImVec2 pos(text_pos.x, text_pos.y + line_n * line_height);
+        for (; line_n < cache->LineStarts.Size && pos.y <= window->ClipRect.Max.y; line_n++, pos.y += line_height)
+        {
+            const char* line = text_begin + cache->LineStarts[line_n];
+            const char* line_end = (line_n + 1 < cache->LineStarts.Size) ? text_begin + cache->LineStarts[line_n + 1] : text_end;
+            RenderText(pos, line, line_end, false);
+        }
+    }
+    else if (text_end - text <= 2000 || wrap_enabled)
     {
         // Common case
         const float wrap_width = wrap_enabled ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
@@ -921,6 +1000,16 @@ void ImGui::Scrollbar(ImGuiAxis axis)
             rounding_corners |= ImDrawFlags_RoundCornersBottomRight;
     }
     float size_avail = window->InnerRect.Max[axis] - window->InnerRect.Min[axis];
+    if (axis == ImGuiAxis_Y && (window->ChildFlags & ImGuiChildFlags_LargeScrollY))
+    {
+        // Scroll through the logical contents height. The position is applied with the window base on the next frame.
+        ImS64 scroll = (ImS64)(window->LargeScrollBaseY + window->Scroll.y);
+        const ImS64 scroll_prev = scroll;
+        ScrollbarEx(bb, id, axis, &scroll, (ImS64)size_avail, (ImS64)(window->LargeContentSizeY + window->WindowPadding.y * 2.0f), rounding_corners);
+        if (scroll != scroll_prev)
+            SetLargeScrollY(window, (double)scroll);
+        return;
+    }
     float size_contents = window->ContentSize[axis] + window->WindowPadding[axis] * 2.0f;
     ImS64 scroll = (ImS64)window->Scroll[axis];
     ScrollbarEx(bb, id, axis, &scroll, (ImS64)size_avail, (ImS64)size_contents, rounding_corners);
@@ -4576,10 +4665,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = (char*)MemAllocFrame(clipboard_data_len * sizeof(char));
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
             }
             if (is_cut)
             {
@@ -4595,7 +4683,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len + 1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)MemAllocFrame((clipboard_len + 1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s != 0; )
                 {
@@ -4611,7 +4699,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
             }
         }
 
@@ -4644,13 +4731,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 apply_new_text = state->InitialTextA.Data;
                 apply_new_text_length = state->InitialTextA.Size - 1;
                 value_changed = true;
-                ImVector<ImWchar> w_text;
+                ImWchar* w_text = NULL;
+                int w_text_len = 0;
                 if (apply_new_text_length > 0)
                 {
-                    w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
-                    ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text_len = ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text = (ImWchar*)MemAllocFrame((w_text_len + 1) * sizeof(ImWchar));
+                    ImTextStrFromUtf8(w_text, w_text_len + 1, apply_new_text, apply_new_text + apply_new_text_length);
                 }
-                stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
+                stb_textedit_replace(state, &state->Stb, w_text, w_text_len);
             }
         }
 
@@ -6617,6 +6706,7 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     if (flags & ImGuiSelectableFlags_AllowDoubleClick)  { button_flags |= ImGuiButtonFlags_PressedOnClickRelease | ImGuiButtonFlags_PressedOnDoubleClick; }
     if ((flags & ImGuiSelectableFlags_AllowOverlap) || (g.LastItemData.InFlags & ImGuiItemFlags_AllowOverlap)) { button_flags |= ImGuiButtonFlags_AllowOverlap; }
 
+    const bool is_multi_select = (g.LastItemData.InFlags & ImGuiItemFlags_HasSelectionUserData) != 0 && g.CurrentMultiSelect != NULL;
     const bool was_selected = selected;
     bool hovered, held;
     bool pressed = ButtonBehavior(bb, id, &hovered, &held, button_flags);
@@ -6632,6 +6722,10 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
         if (g.NavJustMovedToId == id)
             selected = pressed = true;
 
+    // Multi-selection support: clicks and navigation become selection requests, see BeginMultiSelect()
+    if (is_multi_select)
+        MultiSelectItemFooter(id, &selected, &pressed);
+
     // Update NavId when clicking or when Hovering (this doesn't happen on most widgets), so navigation can be resumed with gamepad/keyboard
     if (pressed || (hovered && (flags & ImGuiSelectableFlags_SetNavIdOnHover)))
     {
@@ -6644,7 +6738,7 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     if (pressed)
         MarkItemEdited(id);
 
-    // In this branch, Selectable() cannot toggle the selection so this will never trigger.
+    // Only toggled by MultiSelectItemFooter() or ImGuiSelectableFlags_SelectOnNav.
     if (selected != was_selected) //-V547
         g.LastItemData.StatusFlags |= ImGuiItemStatusFlags_ToggledSelection;
 
@@ -6883,6 +6977,97 @@ void ImGui::DebugNodeTypingSelectState(ImGuiTypingSelectState* data)
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Multi-Select support
 //-------------------------------------------------------------------------
+// - BeginMultiSelect()
+// - EndMultiSelect()
+// - SetNextItemSelectionUserData()
+// - MultiSelectItemFooter() [Internal]
+// - ImGuiSelectionStorage
+//-------------------------------------------------------------------------
+// Selection state is owned by the application. We never iterate items: user inputs are turned into
+// requests over ranges of SetNextItemSelectionUserData() values, so ranges may cover clipped items.
+//-------------------------------------------------------------------------
+
+// A SetAll request supersedes every request made before it.
+static void MultiSelectAddSetAll(ImGuiMultiSelectTempData* ms, bool selected)
+{
+    ImGuiSelectionRequest req = { ImGuiSelectionRequestType_SetAll, selected, 0, ms->IO.ItemsCount - 1 };
+    ms->IO.Requests.resize(0);
+    ms->IO.Requests.push_back(req);
+    ms->IsEndIO = true;
+}
+
+static void MultiSelectAddSetRange(ImGuiMultiSelectTempData* ms, bool selected, ImGuiSelectionUserData first_item, ImGuiSelectionUserData last_item)
+{
+    // Requests returned by BeginMultiSelect() were already applied by the user
+    if (!ms->IsEndIO)
+    {
+        ms->IO.Requests.resize(0);
+        ms->IsEndIO = true;
+    }
+    ImGuiSelectionRequest req = { ImGuiSelectionRequestType_SetRange, selected, ImMin(first_item, last_item), ImMax(first_item, last_item) };
+    ms->IO.Requests.push_back(req);
+}
+
+// Return requests to apply before submitting items: Ctrl+A and Escape.
+// 'items_count' is only required for select all (Ctrl+A), pass -1 if unknown.
+ImGuiMultiSelectIO* ImGui::BeginMultiSelect(ImGuiMultiSelectFlags flags, int items_count)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(g.CurrentMultiSelect == NULL && "Nested BeginMultiSelect() are not supported.");
+
+    ImGuiMultiSelectTempData* ms = &g.MultiSelectTempData;
+    ms->Clear();
+    g.CurrentMultiSelect = ms;
+
+    // Use a focus scope so we can tell when navigation lands in our items
+    const ImGuiID id = window->IDStack.back();
+    ms->FocusScopeId = id;
+    ms->Flags = flags;
+    ms->IsFocused = (g.NavFocusScopeId == id);
+    ms->KeyMods = g.IO.KeyMods;
+    PushFocusScope(id);
+
+    ImGuiMultiSelectState* storage = g.MultiSelectStorage.GetOrAddByKey(id);
+    storage->ID = id;
+    storage->LastTimeActive = (float)g.Time;
+    ms->Storage = storage;
+    ms->IO.ItemsCount = items_count;
+    ms->IO.RangeSrcItem = storage->RangeSrcItem;
+    ms->IO.NavIdItem = storage->NavIdItem;
+
+    if (ms->IsFocused)
+    {
+        if ((flags & ImGuiMultiSelectFlags_ClearOnEscape) && Shortcut(ImGuiKey_Escape))
+            MultiSelectAddSetAll(ms, false);
+        if (!(flags & (ImGuiMultiSelectFlags_SingleSelect | ImGuiMultiSelectFlags_NoSelectAll)) && items_count >= 0 && Shortcut(ImGuiMod_Ctrl | ImGuiKey_A))
+            MultiSelectAddSetAll(ms, true);
+    }
+    ms->IsEndIO = false;
+    return &ms->IO;
+}
+
+// Return requests to apply after submitting items: clicks, Ctrl+Click, Shift+Click, Shift+Arrows.
+ImGuiMultiSelectIO* ImGui::EndMultiSelect()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiMultiSelectTempData* ms = g.CurrentMultiSelect;
+    IM_ASSERT(ms != NULL && "Calling EndMultiSelect() without BeginMultiSelect().");
+    IM_ASSERT(g.CurrentFocusScopeId == ms->FocusScopeId && "Mismatched PushFocusScope()/PopFocusScope() within multi-select block.");
+
+    // Clicking on empty space: no item is hovered
+    if ((ms->Flags & ImGuiMultiSelectFlags_ClearOnClickVoid) && IsWindowHovered() && g.HoveredId == 0 && IsMouseClicked(ImGuiMouseButton_Left))
+        MultiSelectAddSetAll(ms, false);
+
+    if (!ms->IsEndIO)
+        ms->IO.Requests.resize(0);
+    ms->IO.RangeSrcItem = ms->Storage->RangeSrcItem;
+    ms->IO.NavIdItem = ms->Storage->NavIdItem;
+
+    PopFocusScope();
+    g.CurrentMultiSelect = NULL;
+    return &ms->IO;
+}
 
 void ImGui::SetNextItemSelectionUserData(ImGuiSelectionUserData selection_user_data)
 {
@@ -6893,6 +7078,143 @@ void ImGui::SetNextItemSelectionUserData(ImGuiSelectionUserData selection_user_d
     g.NextItemData.SelectionUserData = selection_user_data;
 }
 
+// Called by Selectable() after ButtonBehavior(). 'pressed' is also set when keyboard navigation lands on
+// the item without Ctrl held, so arrows move the selection and Shift+Arrows extend it.
+void ImGui::MultiSelectItemFooter(ImGuiID id, bool* p_selected, bool* p_pressed)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiMultiSelectTempData* ms = g.CurrentMultiSelect;
+    ImGuiMultiSelectState* storage = ms->Storage;
+    const ImGuiSelectionUserData item_data = g.NextItemData.SelectionUserData;
+    IM_ASSERT(item_data != ImGuiSelectionUserData_Invalid);
+
+    bool selected = *p_selected;
+    bool pressed = *p_pressed;
+    ImGuiKeyChord key_mods = ms->KeyMods;
+    if (g.NavJustMovedToId == id && g.NavJustMovedToFocusScopeId == ms->FocusScopeId)
+    {
+        key_mods = g.NavJustMovedToKeyMods;
+        if ((key_mods & ImGuiMod_Ctrl) == 0 || (key_mods & ImGuiMod_Shift) != 0)
+            pressed = true;
+    }
+
+    if (pressed)
+    {
+        const bool is_single = (ms->Flags & ImGuiMultiSelectFlags_SingleSelect) != 0;
+        const bool is_ctrl = (key_mods & ImGuiMod_Ctrl) != 0 && !is_single;
+        const bool is_shift = (key_mods & ImGuiMod_Shift) != 0 && !is_single && !(ms->Flags & ImGuiMultiSelectFlags_NoRangeSelect) && storage->RangeSrcItem != ImGuiSelectionUserData_Invalid;
+        if (is_shift)
+        {
+            // Range from the anchor, which doesn't move. Without Ctrl the range replaces the selection.
+            selected = is_ctrl ? storage->RangeSelected : true;
+            if (!is_ctrl)
+                MultiSelectAddSetAll(ms, false);
+            MultiSelectAddSetRange(ms, selected, storage->RangeSrcItem, item_data);
+        }
+        else
+        {
+            // Ctrl toggles the item, a plain click selects only this item. Both move the anchor.
+            selected = is_ctrl ? !selected : true;
+            if (!is_ctrl)
+                MultiSelectAddSetAll(ms, false);
+            MultiSelectAddSetRange(ms, selected, item_data, item_data);
+            storage->RangeSrcItem = item_data;
+            storage->RangeSelected = selected;
+        }
+        storage->NavIdItem = item_data;
+    }
+    else if (g.NavId == id && g.NavFocusScopeId == ms->FocusScopeId)
+    {
+        storage->NavIdItem = item_data;
+    }
+
+    *p_selected = selected;
+    *p_pressed = pressed;
+}
+
+// Index of the first range with End >= idx (or > idx when 'touching' is false)
+static int ImGuiSelectionStorage_LowerBound(const ImVector<ImGuiSelectionStorage::Range>& ranges, ImS64 idx, bool touching)
+{
+    int lo = 0, hi = ranges.Size;
+    while (lo < hi)
+    {
+        const int mid = lo + (hi - lo) / 2;
+        if (touching ? ranges[mid].End < idx : ranges[mid].End <= idx)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+bool ImGuiSelectionStorage::Contains(ImS64 idx) const
+{
+    const int n = ImGuiSelectionStorage_LowerBound(Ranges, idx, false);
+    return n < Ranges.Size && Ranges[n].Begin <= idx;
+}
+
+void ImGuiSelectionStorage::SetRange(ImS64 first, ImS64 last, bool selected)
+{
+    const ImS64 begin = ImMin(first, last);
+    const ImS64 end = ImMax(first, last) + 1;
+
+    // Ranges [n_first, n_last) overlap [begin, end), or are adjacent to it when selecting so they get merged
+    const int n_first = ImGuiSelectionStorage_LowerBound(Ranges, begin, selected);
+    int n_last = n_first;
+    while (n_last < Ranges.Size && (selected ? Ranges[n_last].Begin <= end : Ranges[n_last].Begin < end))
+        n_last++;
+
+    const bool overlap = n_first < n_last;
+    const ImS64 outer_begin = overlap ? ImMin(Ranges[n_first].Begin, begin) : begin;
+    const ImS64 outer_end = overlap ? ImMax(Ranges[n_last - 1].End, end) : end;
+    if (overlap)
+    {
+        for (int n = n_first; n < n_last; n++)
+            Size -= Ranges[n].End - Ranges[n].Begin;
+        Ranges.erase(Ranges.Data + n_first, Ranges.Data + n_last);
+    }
+
+    if (selected)
+    {
+        Range merged = { outer_begin, outer_end };
+        Ranges.insert(Ranges.Data + n_first, merged);
+        Size += outer_end - outer_begin;
+        return;
+    }
+
+    // Keep what sticks out of [begin, end) on either side
+    int n = n_first;
+    if (outer_begin < begin)
+    {
+        Range left = { outer_begin, begin };
+        Ranges.insert(Ranges.Data + n++, left);
+        Size += begin - outer_begin;
+    }
+    if (end < outer_end)
+    {
+        Range right = { end, outer_end };
+        Ranges.insert(Ranges.Data + n, right);
+        Size += outer_end - end;
+    }
+}
+
+void ImGuiSelectionStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
+{
+    for (const ImGuiSelectionRequest& req : ms_io->Requests)
+    {
+        if (req.Type == ImGuiSelectionRequestType_SetAll)
+        {
+            Clear();
+            if (req.Selected && ms_io->ItemsCount > 0)
+                SetRange(0, ms_io->ItemsCount - 1, true);
+        }
+        else if (req.Type == ImGuiSelectionRequestType_SetRange)
+        {
+            SetRange(req.RangeFirstItem, req.RangeLastItem, req.Selected);
+        }
+    }
+}
+
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: ListBox